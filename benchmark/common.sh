@@ -0,0 +1,73 @@
+##
+## SPDX-License-Identifier: MIT
+## Copyright (C) 2020 by the ryujin authors
+##
+
+#
+# Shared setup of the benchmark scripts. Source this file after setting
+# SOURCE (path to the ryujin source) and, for run_likwid, CORES and
+# LAUNCHER.
+#
+
+PRM="${SOURCE}/benchmark/cylinder.prm"
+
+#
+# configure_and_build <build directory> [cmake options...]
+#
+# Configure a release build of ryujin with the given options and build
+# the executable.
+#
+configure_and_build() {
+  local build="$1"
+  shift
+  mkdir -p "${build}"
+  (
+    cd "${build}"
+    cmake -DCMAKE_BUILD_TYPE=Release "$@" "${SOURCE}" > /dev/null
+    make -j"$(nproc)" ryujin > /dev/null
+  )
+}
+
+#
+# write_prm <parameter file> <subsection> <parameter> <value>
+#
+# Write the cylinder benchmark configuration with one parameter
+# overridden.
+#
+write_prm() {
+  cat "${PRM}" > "$1"
+  cat >> "$1" << EOT
+
+subsection $2
+  set $3 = $4
+end
+EOT
+}
+
+#
+# run_likwid <build directory> <parameter file> <group> <log file>
+#
+# Run the benchmark under likwid-perfctr in marker mode with the given
+# performance group on the cores CORES. Requires a build with
+# LIKWID_PERFMON=ON.
+#
+run_likwid() {
+  local prm log
+  prm="$(realpath "$2")"
+  log="$(realpath -m "$4")"
+  (
+    cd "$1/run"
+    ${LAUNCHER} likwid-perfctr -C "${CORES}" -g "$3" -m \
+      ./ryujin "${prm}" > "${log}"
+  )
+}
+
+#
+# print_statistics <log file>
+#
+# Print the "time step N - ..." timer statistics and the throughput of
+# the final summary.
+#
+print_statistics() {
+  sed -n '/FINAL  (cycle/,$p' "$1" | grep -E "time step [0-9]|\(WALL\)"
+}
@@ -0,0 +1,48 @@
+#!/bin/bash
+##
+## SPDX-License-Identifier: MIT
+## Copyright (C) 2020 by the ryujin authors
+##
+
+#
+# Compare the locality optimizing dof renumberings ("dof renumbering" in
+# subsection "C - OfflineData") on the cylinder benchmark.
+#
+# A single build with LIKWID_PERFMON=ON is configured in build-likwid. For
+# every renumbering the benchmark is run twice under likwid-perfctr in
+# marker mode, once with the L2CACHE and once with the L3CACHE group. The
+# script prints the L2/L3 miss rates and miss ratios of the instrumented
+# regions time_step_0, ..., and the "time step N - ..." timer statistics
+# together with the throughput for every renumbering.
+#
+# Usage: dof_renumbering.sh <path to ryujin source> [cores] [mpi launcher]
+#
+# The cores argument is handed to likwid-perfctr -C (default: 0) and has
+# to match the number of threads used by the binary.
+#
+
+set -e
+
+SOURCE="$(realpath "${1:-..}")"
+CORES="${2:-0}"
+LAUNCHER="${3:-}"
+source "${SOURCE}/benchmark/common.sh"
+
+RENUMBERINGS="cuthill_mckee hilbert morton"
+
+build="build-likwid"
+configure_and_build "${build}" -DLIKWID_PERFMON=ON
+
+for renumbering in ${RENUMBERINGS}; do
+  prm="${build}/run/dof_renumbering-${renumbering}.prm"
+  write_prm "${prm}" "C - OfflineData" "dof renumbering" "${renumbering//_/ }"
+
+  echo "dof renumbering = ${renumbering//_/ }:"
+  for group in L2CACHE L3CACHE; do
+    log="${build}/dof_renumbering-${renumbering}-${group}.log"
+    run_likwid "${build}" "${prm}" "${group}" "${log}"
+    grep -E "^Region time_step|miss (rate|ratio)" "${log}" || true
+  done
+  print_statistics "${log}"
+  echo
+done
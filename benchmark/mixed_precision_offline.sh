@@ -0,0 +1,46 @@
+#!/bin/bash
+##
+## SPDX-License-Identifier: MIT
+## Copyright (C) 2020 by the ryujin authors
+##
+
+#
+# Measure the memory traffic per step with the static offline matrices
+# (mass, beta_ij, c_ij) stored in double and in single precision
+# (USE_MIXED_PRECISION_OFFLINE) on the cylinder benchmark.
+#
+# For both settings a build with LIKWID_PERFMON=ON is configured in
+# build-likwid-offline-<setting>, and the benchmark is run under
+# likwid-perfctr in marker mode with the MEM group. The script prints the
+# memory data volume and bandwidth of the instrumented regions
+# time_step_0, ..., and the "time step N - ..." timer statistics together
+# with the throughput for both settings. The accuracy of the option is
+# checked by validation/mixed_precision.sh.
+#
+# Usage: mixed_precision_offline.sh <path to ryujin source> [cores] [mpi
+# launcher]
+#
+# The cores argument is handed to likwid-perfctr -C (default: 0) and has
+# to match the number of threads used by the binary.
+#
+
+set -e
+
+SOURCE="$(realpath "${1:-..}")"
+CORES="${2:-0}"
+LAUNCHER="${3:-}"
+source "${SOURCE}/benchmark/common.sh"
+
+for setting in OFF ON; do
+  build="build-likwid-offline-${setting}"
+  configure_and_build "${build}" -DLIKWID_PERFMON=ON \
+    -DUSE_MIXED_PRECISION_OFFLINE=${setting}
+
+  echo "USE_MIXED_PRECISION_OFFLINE=${setting}:"
+  log="${build}/mixed_precision_offline-MEM.log"
+  run_likwid "${build}" "${PRM}" MEM "${log}"
+  grep -E "^Region time_step|Memory (data volume|bandwidth)" \
+    "${log}" || true
+  print_statistics "${log}"
+  echo
+done
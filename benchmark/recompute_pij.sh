@@ -0,0 +1,37 @@
+#!/bin/bash
+##
+## SPDX-License-Identifier: MIT
+## Copyright (C) 2020 by the ryujin authors
+##
+
+#
+# Compare stored (RECOMPUTE_PIJ=OFF) and recomputed (RECOMPUTE_PIJ=ON)
+# p_ij on the cylinder benchmark.
+#
+# For both settings a separate build is configured in
+# build-recompute_pij-<setting>, and the benchmark is run with the given
+# MPI launcher (default: "mpirun -np 1"). The script prints the resident
+# memory statistics, the "time step N - ..." timer statistics, and the
+# throughput of the final summary for both settings.
+#
+# Usage: recompute_pij.sh <path to ryujin source> [mpi launcher]
+#
+
+set -e
+
+SOURCE="$(realpath "${1:-..}")"
+LAUNCHER="${2:-mpirun -np 1}"
+source "${SOURCE}/benchmark/common.sh"
+
+for setting in OFF ON; do
+  build="build-recompute_pij-${setting}"
+  configure_and_build "${build}" -DRECOMPUTE_PIJ=${setting}
+  (
+    cd "${build}/run"
+    ${LAUNCHER} ./ryujin "${PRM}" > ../benchmark.log
+  )
+  echo "RECOMPUTE_PIJ=${setting}:"
+  sed -n '/FINAL  (cycle/,$p' "${build}/benchmark.log" | grep "Memory:"
+  print_statistics "${build}/benchmark.log"
+  echo
+done
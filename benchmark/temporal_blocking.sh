@@ -0,0 +1,48 @@
+#!/bin/bash
+##
+## SPDX-License-Identifier: MIT
+## Copyright (C) 2020 by the ryujin authors
+##
+
+#
+# Measure the memory traffic of Step 3 to Step 4 + n_passes with and
+# without temporal blocking ("temporal blocking" in subsection
+# "E - EulerModule") on the cylinder benchmark.
+#
+# A single build with LIKWID_PERFMON=ON is configured in build-likwid. For
+# both settings the benchmark is run under likwid-perfctr in marker mode
+# with the MEM group. The script prints the memory data volume and
+# bandwidth of the instrumented regions time_step_3, time_step_4, ...
+# (one region per stage, phase A and phase B combined), and the
+# "time step N - ..." timer statistics together with the throughput.
+#
+# Usage: temporal_blocking.sh <path to ryujin source> [cores] [mpi launcher]
+#
+# The cores argument is handed to likwid-perfctr -C (default: 0) and has
+# to match the number of threads used by the binary. Temporal blocking
+# only affects blocks away from the MPI halo; run with a single MPI rank
+# per socket to measure the best case.
+#
+
+set -e
+
+SOURCE="$(realpath "${1:-..}")"
+CORES="${2:-0}"
+LAUNCHER="${3:-}"
+source "${SOURCE}/benchmark/common.sh"
+
+build="build-likwid"
+configure_and_build "${build}" -DLIKWID_PERFMON=ON
+
+for blocking in false true; do
+  prm="${build}/run/temporal_blocking-${blocking}.prm"
+  write_prm "${prm}" "E - EulerModule" "temporal blocking" "${blocking}"
+
+  echo "temporal blocking = ${blocking}:"
+  log="${build}/temporal_blocking-${blocking}-MEM.log"
+  run_likwid "${build}" "${prm}" MEM "${log}"
+  grep -E "^Region time_step_[3-9]|Memory (data volume|bandwidth)" \
+    "${log}" || true
+  print_statistics "${log}"
+  echo
+done
@@ -0,0 +1,38 @@
+#!/bin/bash
+##
+## SPDX-License-Identifier: MIT
+## Copyright (C) 2020 by the ryujin authors
+##
+
+#
+# Compare the explicit SSP Runge Kutta schemes on the cylinder benchmark.
+#
+# For every TimeStepOrder a separate build is configured in
+# build-<scheme>, and the benchmark is run with the given MPI launcher
+# (default: "mpirun -np 1"). The script prints the throughput summary,
+# most notably the "simulated time per second" metric, for every scheme.
+#
+# Usage: time_step_order.sh <path to ryujin source> [mpi launcher]
+#
+
+set -e
+
+SOURCE="$(realpath "${1:-..}")"
+LAUNCHER="${2:-mpirun -np 1}"
+source "${SOURCE}/benchmark/common.sh"
+
+SCHEMES="third_order third_order_four_stages third_order_five_stages fourth_order_ten_stages"
+
+for scheme in ${SCHEMES}; do
+  build="build-${scheme}"
+  configure_and_build "${build}" \
+    -DCMAKE_CXX_FLAGS="-DTIME_STEP_ORDER=TimeStepOrder::${scheme}"
+  (
+    cd "${build}/run"
+    ${LAUNCHER} ./ryujin "${PRM}" > ../benchmark.log
+  )
+  echo "TimeStepOrder::${scheme}:"
+  grep "(WALL)" "${build}/benchmark.log" | tail -n 1
+  grep "simulated time per second" "${build}/benchmark.log" | tail -n 1
+  echo
+done
@@ -0,0 +1,242 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 by the ryujin authors
+//
+
+#ifndef BOUNDARY_TABLE_H
+#define BOUNDARY_TABLE_H
+
+#include "discretization.h"
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A flat, indexed replacement of the boundary map for use in hot loops.
+   * Local numbering.
+   *
+   * For every locally relevant index we store a single bit indicating
+   * whether the index is situated at the boundary. All boundary degrees
+   * of freedom are numbered consecutively in ascending order of their
+   * local index ("slots"). For every slot we store the local index, the
+   * boundary id, the position, and the unit normal in structure-of-arrays
+   * layout. The normal is set to zero for all degrees of freedom that do
+   * not have slip boundary conditions. This way the slip fix-up can be
+   * applied unconditionally to all lanes of a SIMD row group.
+   *
+   * The slot of a boundary index is computed in constant time from a
+   * prefix count stored for every 64 bit word of the bitmap. Consecutive
+   * boundary indices have consecutive slots. In particular, the lanes of
+   * a SIMD row group consisting of boundary degrees of freedom occupy
+   * simd_length consecutive slots.
+   *
+   * @ingroup SIMD
+   */
+  template <int dim, typename Number>
+  class BoundaryTable
+  {
+  public:
+    BoundaryTable();
+
+    /**
+     * Populate the boundary table from the given @p boundary_map (a map
+     * from local index to a tuple of normal, boundary id, and position,
+     * see OfflineData::boundary_map()). Normals are expected to be
+     * normalized already.
+     */
+    template <typename BoundaryMap>
+    void reinit(const unsigned int n_locally_relevant,
+                const BoundaryMap &boundary_map);
+
+    /**
+     * Return whether the locally relevant index @p i is situated at the
+     * boundary.
+     */
+    bool is_boundary(const unsigned int i) const;
+
+    /**
+     * Return the slot of the boundary index @p i. Only valid if
+     * is_boundary(i) is true.
+     */
+    unsigned int slot(const unsigned int i) const;
+
+    unsigned int n_boundary_dofs() const;
+
+    unsigned int index(const unsigned int slot) const;
+
+    dealii::types::boundary_id id(const unsigned int slot) const;
+
+    dealii::Point<dim> position(const unsigned int slot) const;
+
+    dealii::Tensor<1, dim, Number> normal(const unsigned int slot) const;
+
+    /**
+     * Return the normals of the simd_length consecutive slots starting
+     * at @p slot.
+     */
+    template <typename VectorizedArray>
+    dealii::Tensor<1, dim, VectorizedArray>
+    get_vectorized_normal(const unsigned int slot) const;
+
+  private:
+    static constexpr unsigned int bits_per_word = 64;
+
+    std::vector<std::uint64_t> bitmap_;
+    std::vector<unsigned int> word_offsets_;
+
+    std::vector<unsigned int> indices_;
+    std::vector<dealii::types::boundary_id> ids_;
+    dealii::AlignedVector<Number> positions_;
+    dealii::AlignedVector<Number> normals_;
+  };
+
+
+  template <int dim, typename Number>
+  BoundaryTable<dim, Number>::BoundaryTable()
+  {
+  }
+
+
+  template <int dim, typename Number>
+  template <typename BoundaryMap>
+  void
+  BoundaryTable<dim, Number>::reinit(const unsigned int n_locally_relevant,
+                                     const BoundaryMap &boundary_map)
+  {
+    const unsigned int n_words =
+        (n_locally_relevant + bits_per_word - 1) / bits_per_word;
+
+    bitmap_.assign(n_words, 0);
+    word_offsets_.assign(n_words + 1, 0);
+
+    const unsigned int n_boundary_dofs = boundary_map.size();
+    indices_.resize(n_boundary_dofs);
+    ids_.resize(n_boundary_dofs);
+    positions_.resize_fast(dim * n_boundary_dofs);
+    normals_.resize_fast(dim * n_boundary_dofs);
+
+    /* The boundary map is sorted by local index: */
+
+    unsigned int k = 0;
+    for (const auto &it : boundary_map) {
+      const unsigned int i = it.first;
+      const auto &[normal, id, position] = it.second;
+      AssertIndexRange(i, n_locally_relevant);
+
+      bitmap_[i / bits_per_word] |= std::uint64_t(1) << (i % bits_per_word);
+      word_offsets_[i / bits_per_word + 1]++;
+
+      indices_[k] = i;
+      ids_[k] = id;
+      for (unsigned int d = 0; d < dim; ++d) {
+        positions_[d * n_boundary_dofs + k] = position[d];
+        normals_[d * n_boundary_dofs + k] =
+            id == Boundary::slip ? normal[d] : Number(0.);
+      }
+      ++k;
+    }
+
+    for (unsigned int w = 0; w < n_words; ++w)
+      word_offsets_[w + 1] += word_offsets_[w];
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline bool
+  BoundaryTable<dim, Number>::is_boundary(const unsigned int i) const
+  {
+    AssertIndexRange(i / bits_per_word, bitmap_.size());
+    return (bitmap_[i / bits_per_word] >> (i % bits_per_word)) & 1;
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  BoundaryTable<dim, Number>::slot(const unsigned int i) const
+  {
+    Assert(is_boundary(i),
+           dealii::ExcMessage("Index is not situated at the boundary"));
+
+    const std::uint64_t mask =
+        (std::uint64_t(1) << (i % bits_per_word)) - std::uint64_t(1);
+    return word_offsets_[i / bits_per_word] +
+           __builtin_popcountll(bitmap_[i / bits_per_word] & mask);
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  BoundaryTable<dim, Number>::n_boundary_dofs() const
+  {
+    return indices_.size();
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  BoundaryTable<dim, Number>::index(const unsigned int slot) const
+  {
+    AssertIndexRange(slot, indices_.size());
+    return indices_[slot];
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline dealii::types::boundary_id
+  BoundaryTable<dim, Number>::id(const unsigned int slot) const
+  {
+    AssertIndexRange(slot, ids_.size());
+    return ids_[slot];
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline dealii::Point<dim>
+  BoundaryTable<dim, Number>::position(const unsigned int slot) const
+  {
+    AssertIndexRange(slot, indices_.size());
+
+    dealii::Point<dim> result;
+    for (unsigned int d = 0; d < dim; ++d)
+      result[d] = positions_[d * indices_.size() + slot];
+    return result;
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, dim, Number>
+  BoundaryTable<dim, Number>::normal(const unsigned int slot) const
+  {
+    AssertIndexRange(slot, indices_.size());
+
+    dealii::Tensor<1, dim, Number> result;
+    for (unsigned int d = 0; d < dim; ++d)
+      result[d] = normals_[d * indices_.size() + slot];
+    return result;
+  }
+
+
+  template <int dim, typename Number>
+  template <typename VectorizedArray>
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, dim, VectorizedArray>
+  BoundaryTable<dim, Number>::get_vectorized_normal(
+      const unsigned int slot) const
+  {
+    AssertIndexRange(slot + VectorizedArray::size() - 1, indices_.size());
+
+    dealii::Tensor<1, dim, VectorizedArray> result;
+    for (unsigned int d = 0; d < dim; ++d)
+      result[d].load(normals_.data() + d * indices_.size() + slot);
+    return result;
+  }
+
+} // namespace ryujin
+
+#endif /* BOUNDARY_TABLE_H */
@@ -6,78 +6,1093 @@
 #ifndef CHECKPOINTING_H
 #define CHECKPOINTING_H
 
+#include "compression.h"
+#include "multicomponent_vector.h"
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/partitioner.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/distributed/solution_transfer.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/lac/la_parallel_vector.h>
 
-#include <boost/archive/binary_iarchive.hpp>
-#include <boost/archive/binary_oarchive.hpp>
-#include <boost/core/demangle.hpp>
+#include <omp.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace ryujin
 {
+  /**
+   * Header of a checkpoint file. A checkpoint consists of this (fixed
+   * size) header followed by the locally owned part of the state vector
+   * U in the native byte order, either raw or compressed (see
+   * compress()). The payload can thus be written and read back with a
+   * single I/O operation.
+   *
+   * @ingroup Miscellaneous
+   */
+  struct CheckpointHeader {
+    /**
+     * Identifies the file as a ryujin checkpoint:
+     */
+    static constexpr char magic_string[8] = {
+        'r', 'y', 'u', 'j', 'i', 'n', 'c', 'p'};
+
+    /**
+     * The current format version. Increment whenever the layout of the
+     * header or the payload changes.
+     */
+    static constexpr std::uint32_t current_version = 2;
+
+    char magic[8];
+    std::uint32_t version;
+
+    /**
+     * Compile-time configuration: dim, sizeof(Number), and the number of
+     * components (problem_dimension) of the state vector.
+     */
+    std::uint32_t dim;
+    std::uint32_t number_size;
+    std::uint32_t n_components;
+
+    /**
+     * The partition layout: Number of MPI ranks, the subdomain id of the
+     * writing rank, the global size and the locally owned range [begin,
+     * begin + local_size) of the (multicomponent) state vector.
+     */
+    std::uint32_t n_mpi_processes;
+    std::uint32_t subdomain_id;
+
+    /**
+     * The Codec used for the payload, and the size of the payload in
+     * bytes.
+     */
+    std::uint32_t codec;
+    std::uint32_t reserved;
+    std::uint64_t payload_size;
+
+    std::uint64_t global_size;
+    std::uint64_t local_range_begin;
+    std::uint64_t local_size;
+
+    /**
+     * The saved time and output cycle.
+     */
+    double t;
+    std::uint64_t output_cycle;
+
+    /**
+     * Checksum of the uncompressed payload, see checkpoint_checksum().
+     */
+    std::uint64_t checksum;
+  };
+
+  static_assert(std::is_trivially_copyable<CheckpointHeader>::value &&
+                    sizeof(CheckpointHeader) == 96,
+                "CheckpointHeader must not contain padding");
+
+
+  /**
+   * Compute a 64bit FNV-1a checksum of the memory region [@p data, @p
+   * data + @p size) (size in bytes). In order to run at close to memory
+   * bandwidth the data is processed in 8 byte words instead of single
+   * bytes.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline std::uint64_t checkpoint_checksum(const void *data,
+                                           const std::size_t size)
+  {
+    constexpr std::uint64_t prime = 1099511628211ull;
+    std::uint64_t hash = 14695981039346656037ull;
+
+    const auto bytes = static_cast<const unsigned char *>(data);
+    const std::size_t size_regular = size / 8 * 8;
+
+    for (std::size_t k = 0; k < size_regular; k += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + k, 8);
+      hash = (hash ^ word) * prime;
+    }
+
+    for (std::size_t k = size_regular; k < size; ++k)
+      hash = (hash ^ bytes[k]) * prime;
+
+    return hash;
+  }
+
+
+  /**
+   * Return the name of the checkpoint file of subdomain @p id.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline std::string checkpoint_name(const std::string &base_name,
+                                     const unsigned int id)
+  {
+    return base_name + "-checkpoint-" +
+           dealii::Utilities::int_to_string(id, 4) + ".archive";
+  }
+
+
+  /**
+   * Populate a CheckpointHeader for the state @p U at time @p t and
+   * output cycle @p output_cycle written by subdomain @p id. The
+   * checksum is left at zero.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <int dim, typename Number, int n_comp, int simd_length>
+  CheckpointHeader make_checkpoint_header(
+      const unsigned int id,
+      const MultiComponentVector<Number, n_comp, simd_length> &U,
+      const Number t,
+      const unsigned int output_cycle)
+  {
+    const auto &partitioner = *U.get_partitioner();
+
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CheckpointHeader::magic_string, 8);
+    header.version = CheckpointHeader::current_version;
+    header.dim = dim;
+    header.number_size = sizeof(Number);
+    header.n_components = n_comp;
+    header.n_mpi_processes = partitioner.n_mpi_processes();
+    header.subdomain_id = id;
+    header.global_size = partitioner.size();
+    header.local_range_begin = partitioner.local_range().first;
+    header.local_size = partitioner.local_size();
+    header.codec = static_cast<std::uint32_t>(Codec::none);
+    header.payload_size = header.local_size * sizeof(Number);
+    header.t = t;
+    header.output_cycle = output_cycle;
+    return header;
+  }
+
+
   /**
    * Performs a resume operation. Given a @p base_name the function tries
-   * to locate correponding checkpoint files and will read in the saved
-   * state @p U at saved time @p t with saved output cycle @p output_cycle.
+   * to locate the corresponding checkpoint file of subdomain @p id and
+   * reads in the saved state @p U at saved time @p t with saved output
+   * cycle @p output_cycle.
    *
-   * @todo Some day, we should refactor this into a class and do something
-   * smarter...
+   * The function throws an exception if the checkpoint was written with
+   * a different compile-time configuration or partition layout, or if
+   * the payload does not match its checksum.
    *
    * @ingroup Miscellaneous
    */
-  template<typename T1, typename T2, typename T3>
+  template <int dim, typename Number, int n_comp, int simd_length>
   void do_resume(const std::string &base_name,
                  unsigned int id,
-                 T1 &U,
-                 T2 &t,
-                 T3 &output_cycle)
+                 MultiComponentVector<Number, n_comp, simd_length> &U,
+                 Number &t,
+                 unsigned int &output_cycle)
   {
-    std::string name = base_name + "-checkpoint-" +
-                       dealii::Utilities::int_to_string(id, 4) + ".archive";
+    const std::string name = checkpoint_name(base_name, id);
     std::ifstream file(name, std::ios::binary);
+    AssertThrow(file.good(),
+                dealii::ExcMessage("Could not open checkpoint file " + name));
+
+    CheckpointHeader header;
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    AssertThrow(file.good() &&
+                    std::memcmp(header.magic,
+                                CheckpointHeader::magic_string,
+                                8) == 0 &&
+                    header.version == CheckpointHeader::current_version,
+                dealii::ExcMessage("File " + name +
+                                   " is not a checkpoint of the current "
+                                   "format version"));
 
-    boost::archive::binary_iarchive ia(file);
-    ia >> t >> output_cycle;
+    const auto expected = make_checkpoint_header<dim>(id, U, t, output_cycle);
+    AssertThrow(header.dim == expected.dim &&
+                    header.number_size == expected.number_size &&
+                    header.n_components == expected.n_components,
+                dealii::ExcMessage("Checkpoint " + name +
+                                   " was written with a different "
+                                   "compile-time configuration"));
+    AssertThrow(header.n_mpi_processes == expected.n_mpi_processes &&
+                    header.subdomain_id == expected.subdomain_id &&
+                    header.global_size == expected.global_size &&
+                    header.local_range_begin == expected.local_range_begin &&
+                    header.local_size == expected.local_size,
+                dealii::ExcMessage("Checkpoint " + name +
+                                   " was written with a different partition "
+                                   "layout"));
 
-    for (auto &it : U) {
-      ia >> it;
+    /*
+     * Read an uncompressed payload straight into the locally owned range
+     * of U, otherwise decompress it:
+     */
+    const std::size_t size = header.local_size * sizeof(Number);
+    if (header.codec == static_cast<std::uint32_t>(Codec::none)) {
+      AssertThrow(header.payload_size == size,
+                  dealii::ExcMessage("Corrupted checkpoint " + name));
+      file.read(reinterpret_cast<char *>(U.begin()), size);
+      AssertThrow(file.good(),
+                  dealii::ExcMessage("Could not read checkpoint file " +
+                                     name));
+    } else {
+      std::vector<char> payload(header.payload_size);
+      file.read(payload.data(), payload.size());
+      AssertThrow(file.good(),
+                  dealii::ExcMessage("Could not read checkpoint file " +
+                                     name));
+      decompress(payload.data(),
+                 payload.size(),
+                 U.begin(),
+                 header.local_size,
+                 omp_get_max_threads());
     }
+
+    AssertThrow(checkpoint_checksum(U.begin(), size) == header.checksum,
+                dealii::ExcMessage("Checksum mismatch in checkpoint " + name));
+
+    t = header.t;
+    output_cycle = header.output_cycle;
+
     U.update_ghost_values();
   }
 
 
+  /**
+   * Write a checkpoint file @p name consisting of @p header followed by
+   * the payload [@p payload, @p payload + @p size) (size in bytes).
+   *
+   * The file is first written to a temporary file and flushed to disk
+   * with fsync(). It then atomically replaces a previous checkpoint with
+   * the same name, such that an interruption at any point leaves a
+   * complete checkpoint behind. The previous checkpoint is kept with a
+   * "~" suffix.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline void write_checkpoint_file(const std::string &name,
+                                    const CheckpointHeader &header,
+                                    const void *payload,
+                                    const std::size_t size)
+  {
+    const std::string temporary_name = name + ".tmp";
+
+    const int fd =
+        ::open(temporary_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    AssertThrow(fd != -1,
+                dealii::ExcMessage("Could not open checkpoint file " +
+                                   temporary_name));
+
+    /* write() may return early for large sizes, or when interrupted: */
+    const auto write_all = [fd](const void *data, std::size_t n) {
+      auto pointer = static_cast<const char *>(data);
+      while (n > 0) {
+        const auto written = ::write(fd, pointer, n);
+        if (written < 0 && errno == EINTR)
+          continue;
+        if (written <= 0)
+          return false;
+        pointer += written;
+        n -= written;
+      }
+      return true;
+    };
+
+    const bool success = write_all(&header, sizeof(header)) &&
+                         write_all(payload, size) && ::fsync(fd) == 0;
+    const bool closed = ::close(fd) == 0;
+    AssertThrow(success && closed,
+                dealii::ExcMessage("Could not write checkpoint file " +
+                                   temporary_name));
+
+    /*
+     * Keep the previous checkpoint as a hard link. If the file system
+     * does not support hard links we fall back to renaming it, which
+     * leaves a short window without a checkpoint under the final name:
+     */
+    if (std::filesystem::exists(name)) {
+      std::error_code ec;
+      std::filesystem::remove(name + "~", ec);
+      std::filesystem::create_hard_link(name, name + "~", ec);
+      if (ec)
+        std::filesystem::rename(name, name + "~");
+    }
+
+    std::filesystem::rename(temporary_name, name);
+  }
+
+
+  namespace internal
+  {
+    /*
+     * Compute the checksum of the locally owned part @p values of the
+     * state vector and write a checkpoint file with @p codec. Returns
+     * the compression statistics:
+     */
+    template <typename Number>
+    CompressionStatistics
+    write_compressed_checkpoint_file(const std::string &name,
+                                     CheckpointHeader header,
+                                     const Number *values,
+                                     const Codec codec,
+                                     const unsigned int n_threads)
+    {
+      const std::size_t size = header.local_size * sizeof(Number);
+      header.checksum = checkpoint_checksum(values, size);
+
+      CompressionStatistics statistics;
+      if (codec == Codec::none) {
+        write_checkpoint_file(name, header, values, size);
+        return statistics;
+      }
+
+      const auto payload = compress(codec,
+                                    values,
+                                    header.local_size,
+                                    header.n_components,
+                                    0.,
+                                    n_threads,
+                                    &statistics);
+      header.codec = static_cast<std::uint32_t>(codec);
+      header.payload_size = payload.size();
+      write_checkpoint_file(name, header, payload.data(), payload.size());
+      return statistics;
+    }
+  } // namespace internal
+
+
   /**
    * Writes out a checkpoint to disk. Given a @p base_name and a current
    * state @p U at time @p t and output cycle @p output_cycle the function
-   * writes out the state to disk using boost::archive for serialization.
+   * writes out a CheckpointHeader followed by the locally owned part of
+   * U, see write_checkpoint_file(). The payload is compressed with the
+   * lossless @p codec (using all OpenMP threads). Returns the
+   * compression statistics.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <int dim, typename Number, int n_comp, int simd_length>
+  CompressionStatistics
+  do_checkpoint(const std::string &base_name,
+                unsigned int id,
+                const MultiComponentVector<Number, n_comp, simd_length> &U,
+                const Number t,
+                const unsigned int output_cycle,
+                const Codec codec = Codec::none)
+  {
+    AssertThrow(codec != Codec::quantize,
+                dealii::ExcMessage("Checkpoints require a lossless codec"));
+
+    return internal::write_compressed_checkpoint_file(
+        checkpoint_name(base_name, id),
+        make_checkpoint_header<dim>(id, U, t, output_cycle),
+        U.begin(),
+        codec,
+        omp_get_max_threads());
+  }
+
+
+  /**
+   * Asynchronous checkpointing. schedule_checkpoint() copies the locally
+   * owned part of the state vector into a staging buffer and returns.
+   * The checksum computation, the (optional) compression, and the
+   * write-out (see write_checkpoint_file()) are then performed on a
+   * single background thread while time stepping continues.
+   *
+   * The staging buffer is allocated once and reused for all subsequent
+   * checkpoints.
+   *
+   * @ingroup Miscellaneous
+   */
+  class CheckpointWriter
+  {
+  public:
+    /**
+     * Destructor. Waits for a checkpoint that is still in flight. A
+     * destructor must not throw, thus an error that occurred on the
+     * background thread and was not already reported by wait() is
+     * printed to std::cerr instead.
+     */
+    ~CheckpointWriter()
+    {
+      try {
+        wait();
+      } catch (const std::exception &exception) {
+        std::cerr << "Error while writing a checkpoint in the background: "
+                  << exception.what() << std::endl;
+      } catch (...) {
+        std::cerr << "Unknown error while writing a checkpoint in the "
+                     "background"
+                  << std::endl;
+      }
+    }
+
+    /**
+     * Schedule a checkpoint of state @p U at time @p t and output cycle
+     * @p output_cycle for subdomain @p id, see do_checkpoint(). If a
+     * previous checkpoint is still in flight the function first waits for
+     * it to finish.
+     */
+    template <int dim, typename Number, int n_comp, int simd_length>
+    void schedule_checkpoint(
+        const std::string &base_name,
+        unsigned int id,
+        const MultiComponentVector<Number, n_comp, simd_length> &U,
+        const Number t,
+        const unsigned int output_cycle,
+        const Codec codec = Codec::none)
+    {
+      AssertThrow(codec != Codec::quantize,
+                  dealii::ExcMessage("Checkpoints require a lossless codec"));
+
+      wait();
+
+      const auto header = make_checkpoint_header<dim>(id, U, t, output_cycle);
+      const std::size_t size = header.local_size * sizeof(Number);
+
+      staging_buffer_.resize(size);
+      std::memcpy(staging_buffer_.data(), U.begin(), size);
+
+      background_thread_status_ = std::async(
+          std::launch::async,
+          [this, header, codec, name = checkpoint_name(base_name, id)]() {
+            return internal::write_compressed_checkpoint_file(
+                name,
+                header,
+                reinterpret_cast<const Number *>(staging_buffer_.data()),
+                codec,
+                /*n_threads*/ 1);
+          });
+    }
+
+    /**
+     * Returns true if a checkpoint is currently written out to disk.
+     */
+    bool is_active() const
+    {
+      if (!background_thread_status_.valid())
+        return false;
+
+      return (std::future_status::ready !=
+              background_thread_status_.wait_for(std::chrono::nanoseconds(0)));
+    }
+
+    /**
+     * Wait for a checkpoint in flight to finish and return its
+     * compression statistics. Errors that occurred on the background
+     * thread are rethrown.
+     */
+    CompressionStatistics wait()
+    {
+      if (background_thread_status_.valid())
+        return background_thread_status_.get();
+      return CompressionStatistics();
+    }
+
+  private:
+    std::vector<char> staging_buffer_;
+
+    std::future<CompressionStatistics> background_thread_status_;
+  };
+
+
+  /**
+   * Return the name of the directory of a repartitionable checkpoint.
+   * The name refers to a symbolic link pointing to one of two generation
+   * directories with suffixes ".0" and ".1", see
+   * do_checkpoint_repartitionable().
+   *
+   * @ingroup Miscellaneous
+   */
+  inline std::string
+  repartitionable_checkpoint_directory(const std::string &base_name)
+  {
+    return base_name + "-checkpoint.repartitionable";
+  }
+
+
+  /**
+   * Return the name of the mesh archive of a repartitionable checkpoint.
+   * dealii::parallel::distributed::Triangulation::save() creates
+   * additional files with suffixes ".info", "_fixed.data", and
+   * "_variable.data".
+   *
+   * @ingroup Miscellaneous
+   */
+  inline std::string repartitionable_checkpoint_name(
+      const std::string &base_name)
+  {
+    return repartitionable_checkpoint_directory(base_name) + "/mesh";
+  }
+
+
+  /**
+   * Writes out a repartitionable checkpoint. In contrast to
+   * do_checkpoint() the state @p U is attached cell-wise to the p4est
+   * forest with dealii::parallel::distributed::SolutionTransfer and
+   * written out together with the mesh by
+   * dealii::parallel::distributed::Triangulation::save(). The checkpoint
+   * can thus be resumed with an arbitrary number of MPI ranks, see
+   * do_resume_repartitionable(). The time @p t and output cycle @p
+   * output_cycle are stored in a small CheckpointHeader written by rank
+   * 0.
+   *
+   * All files of a checkpoint are written into a generation directory
+   * that is not referenced by repartitionable_checkpoint_directory().
+   * Once complete, rank 0 switches the symbolic link to the new
+   * generation with a single rename, such that an interruption at any
+   * point leaves a complete checkpoint behind. The previous generation
+   * is kept until the next checkpoint is written.
+   *
+   * The function is collective and synchronous. If a file system
+   * operation on rank 0 fails, all ranks throw an exception.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <int dim, typename Number, int n_comp, int simd_length>
+  void do_checkpoint_repartitionable(
+      const std::string &base_name,
+      const dealii::DoFHandler<dim> &dof_handler,
+      const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+          &scalar_partitioner,
+      const MultiComponentVector<Number, n_comp, simd_length> &U,
+      const Number t,
+      const unsigned int output_cycle)
+  {
+    using scalar_type = dealii::LinearAlgebra::distributed::Vector<Number>;
+
+    const auto &triangulation =
+        dynamic_cast<const dealii::parallel::distributed::Triangulation<dim> &>(
+            dof_handler.get_triangulation());
+    const auto mpi_communicator = triangulation.get_communicator();
+
+    /* Attach all components (with ghost values) to the forest: */
+
+    std::vector<scalar_type> components(n_comp);
+    std::vector<const scalar_type *> pointers;
+    for (unsigned int k = 0; k < n_comp; ++k) {
+      components[k].reinit(scalar_partitioner);
+      U.extract_component(components[k], k);
+      pointers.push_back(&components[k]);
+    }
+
+    dealii::parallel::distributed::SolutionTransfer<dim, scalar_type>
+        solution_transfer(dof_handler);
+    solution_transfer.prepare_for_serialization(pointers);
+
+    const std::string directory =
+        repartitionable_checkpoint_directory(base_name);
+    const bool is_root =
+        dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0;
+
+    /*
+     * All file system operations are carried out by rank 0. Broadcast
+     * whether they succeeded, such that all ranks throw together instead
+     * of waiting for rank 0 in a subsequent collective operation:
+     */
+    const auto on_root = [&](const auto &operation) {
+      int success = 1;
+      std::string message;
+      if (is_root) {
+        try {
+          operation();
+        } catch (const std::exception &exception) {
+          success = 0;
+          message = exception.what();
+        }
+      }
+
+      const int ierr = MPI_Bcast(&success, 1, MPI_INT, 0, mpi_communicator);
+      AssertThrowMPI(ierr);
+      AssertThrow(success == 1,
+                  dealii::ExcMessage("Could not write checkpoint " +
+                                     directory +
+                                     (message.empty() ? "" : ": ") +
+                                     message));
+    };
+
+    /*
+     * Pick the generation the link does not point to and clear it. Rank 0
+     * decides and broadcasts the choice:
+     */
+
+    int generation = 0;
+    on_root([&]() {
+      AssertThrow(!std::filesystem::exists(directory) ||
+                      std::filesystem::is_symlink(directory),
+                  dealii::ExcMessage(directory + " is not a symbolic link"));
+
+      if (std::filesystem::is_symlink(directory) &&
+          std::filesystem::read_symlink(directory).string().back() == '0')
+        generation = 1;
+
+      const std::string generation_directory =
+          directory + "." + std::to_string(generation);
+      std::filesystem::remove_all(generation_directory);
+      std::filesystem::create_directory(generation_directory);
+    });
+
+    int ierr = MPI_Bcast(&generation, 1, MPI_INT, 0, mpi_communicator);
+    AssertThrowMPI(ierr);
+
+    const std::string generation_directory =
+        directory + "." + std::to_string(generation);
+    triangulation.save(generation_directory + "/mesh");
+
+    on_root([&]() {
+      /* The header is only meaningful for the global vector: */
+      auto header = make_checkpoint_header<dim>(0, U, t, output_cycle);
+      header.local_range_begin = 0;
+      header.local_size = 0;
+      header.payload_size = 0;
+      header.checksum = checkpoint_checksum(nullptr, 0);
+      write_checkpoint_file(
+          generation_directory + "/header", header, nullptr, 0);
+
+      /* Atomically replace the link with a relative one: */
+      const std::string temporary_link = directory + ".tmp";
+      std::filesystem::remove(temporary_link);
+      std::filesystem::create_directory_symlink(
+          std::filesystem::path(generation_directory).filename(),
+          temporary_link);
+      std::filesystem::rename(temporary_link, directory);
+    });
+  }
+
+
+  /**
+   * Performs a resume operation from a checkpoint written by
+   * do_checkpoint_repartitionable(). The mesh has to be loaded
+   * beforehand by passing repartitionable_checkpoint_name() to
+   * Discretization::prepare(), and @p dof_handler, @p
+   * scalar_partitioner, and @p U have to be set up for the loaded mesh.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <int dim, typename Number, int n_comp, int simd_length>
+  void do_resume_repartitionable(
+      const std::string &base_name,
+      const dealii::DoFHandler<dim> &dof_handler,
+      const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+          &scalar_partitioner,
+      MultiComponentVector<Number, n_comp, simd_length> &U,
+      Number &t,
+      unsigned int &output_cycle)
+  {
+    using scalar_type = dealii::LinearAlgebra::distributed::Vector<Number>;
+
+    const auto mpi_communicator = scalar_partitioner->get_mpi_communicator();
+    const std::string name =
+        repartitionable_checkpoint_directory(base_name) + "/header";
+
+    /* Read the header on rank 0 and broadcast it: */
+
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
+      std::ifstream file(name, std::ios::binary);
+      file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    }
+
+    const int ierr = MPI_Bcast(
+        &header, sizeof(header), MPI_BYTE, 0, mpi_communicator);
+    AssertThrowMPI(ierr);
+
+    AssertThrow(std::memcmp(header.magic,
+                            CheckpointHeader::magic_string,
+                            8) == 0 &&
+                    header.version == CheckpointHeader::current_version,
+                dealii::ExcMessage("File " + name +
+                                   " is not a checkpoint header of the "
+                                   "current format version"));
+
+    const auto expected = make_checkpoint_header<dim>(0, U, t, output_cycle);
+    AssertThrow(header.dim == expected.dim &&
+                    header.number_size == expected.number_size &&
+                    header.n_components == expected.n_components &&
+                    header.global_size == expected.global_size,
+                dealii::ExcMessage("Checkpoint " + name +
+                                   " was written with a different "
+                                   "compile-time configuration or mesh"));
+
+    /* Retrieve all components from the forest: */
+
+    std::vector<scalar_type> components(n_comp);
+    std::vector<scalar_type *> pointers;
+    for (unsigned int k = 0; k < n_comp; ++k) {
+      components[k].reinit(scalar_partitioner);
+      pointers.push_back(&components[k]);
+    }
+
+    dealii::parallel::distributed::SolutionTransfer<dim, scalar_type>
+        solution_transfer(dof_handler);
+    solution_transfer.deserialize(pointers);
+
+    for (unsigned int k = 0; k < n_comp; ++k)
+      U.insert_component(components[k], k);
+
+    t = header.t;
+    output_cycle = header.output_cycle;
+
+    U.update_ghost_values();
+  }
+
+
+  /**
+   * Write a shared file @p name with collective MPI-IO. The file consists
+   * of @p header (written by rank 0), a table with one entry (byte
+   * offset, size, checksum) per rank describing its slice of the
+   * payload, and the payload. Every rank writes its slice [@p payload,
+   * @p payload + @p size) (size in bytes) at position @p offset of the
+   * payload region and stores @p checksum in its table entry.
+   *
+   * The number of aggregators used for collective buffering can be set
+   * with @p n_aggregators (the "cb_nodes" hint). A value of zero leaves
+   * the choice to the MPI implementation. In contrast to one file per
+   * rank this results in a constant number of metadata operations per
+   * write.
+   *
+   * The file is written to a temporary file first and renamed to @p
+   * name once complete. A previous file with the same name is kept with
+   * a "~" suffix. The function is collective.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline void write_shared_file(const std::string &name,
+                                const MPI_Comm &mpi_communicator,
+                                const CheckpointHeader &header,
+                                const void *payload,
+                                const std::size_t size,
+                                const std::uint64_t offset,
+                                const std::uint64_t checksum,
+                                const unsigned int n_aggregators)
+  {
+    const std::string temporary_name = name + ".tmp";
+    const unsigned int this_mpi_process =
+        dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+    const unsigned int n_mpi_processes =
+        dealii::Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    MPI_Info info;
+    int ierr = MPI_Info_create(&info);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Info_set(info, "romio_cb_write", "enable");
+    AssertThrowMPI(ierr);
+    if (n_aggregators > 0) {
+      ierr = MPI_Info_set(
+          info, "cb_nodes", std::to_string(n_aggregators).c_str());
+      AssertThrowMPI(ierr);
+    }
+
+    MPI_File file;
+    ierr = MPI_File_open(mpi_communicator,
+                         temporary_name.c_str(),
+                         MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                         info,
+                         &file);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Info_free(&info);
+    AssertThrowMPI(ierr);
+
+    /* Discard the contents of a stale temporary file: */
+    ierr = MPI_File_set_size(file, 0);
+    AssertThrowMPI(ierr);
+
+    if (this_mpi_process == 0) {
+      ierr = MPI_File_write_at(
+          file, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+
+    const std::uint64_t entry[3] = {offset, size, checksum};
+    ierr = MPI_File_write_at_all(file,
+                                 sizeof(header) +
+                                     this_mpi_process * sizeof(entry),
+                                 entry,
+                                 sizeof(entry),
+                                 MPI_BYTE,
+                                 MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+
+    /*
+     * Write the payload in rounds of at most 1 GiB per rank, such that
+     * all counts fit into an int:
+     */
+    const std::uint64_t payload_begin =
+        sizeof(header) + n_mpi_processes * sizeof(entry) + offset;
+
+    constexpr std::size_t max_chunk = std::size_t(1) << 30;
+    const std::uint64_t n_rounds = dealii::Utilities::MPI::max<std::uint64_t>(
+        (size + max_chunk - 1) / max_chunk, mpi_communicator);
+
+    const auto bytes = static_cast<const char *>(payload);
+    for (std::uint64_t round = 0; round < n_rounds; ++round) {
+      const std::size_t begin = std::min<std::size_t>(size, round * max_chunk);
+      const std::size_t count = std::min(size - begin, max_chunk);
+      ierr = MPI_File_write_at_all(file,
+                                   payload_begin + begin,
+                                   bytes + begin,
+                                   count,
+                                   MPI_BYTE,
+                                   MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+
+    ierr = MPI_File_sync(file);
+    AssertThrowMPI(ierr);
+    ierr = MPI_File_close(&file);
+    AssertThrowMPI(ierr);
+
+    if (this_mpi_process == 0) {
+      if (std::filesystem::exists(name))
+        std::filesystem::rename(name, name + "~");
+      std::filesystem::rename(temporary_name, name);
+    }
+
+    ierr = MPI_Barrier(mpi_communicator);
+    AssertThrowMPI(ierr);
+  }
+
+
+  /**
+   * Return the name of the shared checkpoint file written by
+   * write_shared_snapshot().
+   *
+   * @ingroup Miscellaneous
+   */
+  inline std::string shared_checkpoint_name(const std::string &base_name)
+  {
+    return base_name + "-checkpoint.shared";
+  }
+
+
+  /**
+   * Write the state @p U at time @p t and output cycle @p output_cycle
+   * into a single shared file @p name, see write_shared_file(). The file
+   * consists of a CheckpointHeader describing the global vector, the
+   * table of slices, and the locally owned parts of all ranks in global
+   * index order. It is used for checkpoints (see do_resume_shared()) as
+   * well as for raw field output.
+   *
+   * The slices are compressed with @p codec (using all OpenMP threads).
+   * For Codec::none every slice is stored at its global position, i.e.,
+   * the payload is the raw global vector. @p tolerance is the maximal
+   * absolute error for Codec::quantize.
+   *
+   * Every table entry stores the checkpoint_checksum() of the
+   * uncompressed locally owned part of its rank. The header additionally
+   * stores the (wrapping) sum of all of them. Returns the compression
+   * statistics of the calling rank.
    *
-   * @todo Some day, we should refactor this into a class and do something
-   * smarter...
+   * @ingroup Miscellaneous
+   */
+  template <int dim, typename Number, int n_comp, int simd_length>
+  CompressionStatistics write_shared_snapshot(
+      const std::string &name,
+      const MultiComponentVector<Number, n_comp, simd_length> &U,
+      const Number t,
+      const unsigned int output_cycle,
+      const unsigned int n_aggregators,
+      const Codec codec = Codec::none,
+      const double tolerance = 0.)
+  {
+    const auto &mpi_communicator = U.get_partitioner()->get_mpi_communicator();
+
+    auto header = make_checkpoint_header<dim>(0, U, t, output_cycle);
+    const std::size_t size = header.local_size * sizeof(Number);
+
+    const std::uint64_t checksum = checkpoint_checksum(U.begin(), size);
+    header.checksum =
+        dealii::Utilities::MPI::sum<std::uint64_t>(checksum, mpi_communicator);
+
+    CompressionStatistics statistics;
+    std::vector<char> compressed;
+    if (codec != Codec::none)
+      compressed = compress(codec,
+                            U.begin(),
+                            header.local_size,
+                            n_comp,
+                            tolerance,
+                            omp_get_max_threads(),
+                            &statistics);
+
+    const void *payload =
+        codec == Codec::none ? static_cast<const void *>(U.begin())
+                             : static_cast<const void *>(compressed.data());
+    const std::uint64_t payload_size =
+        codec == Codec::none ? size : compressed.size();
+
+    /* Position of the slice within the payload region: */
+    std::uint64_t offset = 0;
+    int ierr = MPI_Exscan(&payload_size,
+                          &offset,
+                          1,
+                          MPI_UINT64_T,
+                          MPI_SUM,
+                          mpi_communicator);
+    AssertThrowMPI(ierr);
+    if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+      offset = 0;
+
+    header.codec = static_cast<std::uint32_t>(codec);
+    header.payload_size =
+        dealii::Utilities::MPI::sum(payload_size, mpi_communicator);
+    header.local_range_begin = 0;
+    header.local_size = header.global_size;
+
+    write_shared_file(name,
+                      mpi_communicator,
+                      header,
+                      payload,
+                      payload_size,
+                      offset,
+                      checksum,
+                      n_aggregators);
+
+    return statistics;
+  }
+
+
+  /**
+   * Performs a resume operation from a shared file @p name written by
+   * write_shared_snapshot(). All ranks read (and decompress) their
+   * locally owned part of @p U with collective MPI-IO and verify it
+   * against the checksum stored in its table entry. The checkpoint has
+   * to be resumed with the same number of MPI ranks.
    *
    * @ingroup Miscellaneous
    */
-  template<typename T1, typename T2, typename T3>
-  void do_checkpoint(const std::string &base_name,
-                     unsigned int id,
-                     const T1 &U,
-                     const T2 t,
-                     const T3 output_cycle)
+  template <int dim, typename Number, int n_comp, int simd_length>
+  void do_resume_shared(const std::string &name,
+                        MultiComponentVector<Number, n_comp, simd_length> &U,
+                        Number &t,
+                        unsigned int &output_cycle)
   {
-    std::string name = base_name + "-checkpoint-" +
-                       dealii::Utilities::int_to_string(id, 4) + ".archive";
+    const auto &mpi_communicator = U.get_partitioner()->get_mpi_communicator();
+    const unsigned int this_mpi_process =
+        dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
 
-    if (std::filesystem::exists(name))
-      std::filesystem::rename(name, name + "~");
+    MPI_File file;
+    int ierr = MPI_File_open(mpi_communicator,
+                             name.c_str(),
+                             MPI_MODE_RDONLY,
+                             MPI_INFO_NULL,
+                             &file);
+    AssertThrowMPI(ierr);
 
-    std::ofstream file(name, std::ios::binary | std::ios::trunc);
+    CheckpointHeader header;
+    ierr = MPI_File_read_at_all(
+        file, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
 
-    boost::archive::binary_oarchive oa(file);
-    oa << t << output_cycle;
-    for (const auto &it : U)
-      oa << it;
+    AssertThrow(std::memcmp(header.magic,
+                            CheckpointHeader::magic_string,
+                            8) == 0 &&
+                    header.version == CheckpointHeader::current_version,
+                dealii::ExcMessage("File " + name +
+                                   " is not a checkpoint of the current "
+                                   "format version"));
+
+    const auto expected = make_checkpoint_header<dim>(0, U, t, output_cycle);
+    AssertThrow(header.dim == expected.dim &&
+                    header.number_size == expected.number_size &&
+                    header.n_components == expected.n_components,
+                dealii::ExcMessage("Checkpoint " + name +
+                                   " was written with a different "
+                                   "compile-time configuration"));
+    AssertThrow(header.n_mpi_processes == expected.n_mpi_processes &&
+                    header.global_size == expected.global_size,
+                dealii::ExcMessage("Checkpoint " + name +
+                                   " was written with a different partition "
+                                   "layout"));
+    AssertThrow(header.codec != static_cast<std::uint32_t>(Codec::quantize),
+                dealii::ExcMessage("File " + name +
+                                   " was written with a lossy codec and "
+                                   "cannot be used for resume"));
+
+    std::uint64_t entry[3];
+    ierr = MPI_File_read_at_all(file,
+                                sizeof(header) +
+                                    this_mpi_process * sizeof(entry),
+                                entry,
+                                sizeof(entry),
+                                MPI_BYTE,
+                                MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+
+    const std::uint64_t payload_begin =
+        sizeof(header) + header.n_mpi_processes * sizeof(entry) + entry[0];
+    const std::size_t payload_size = entry[1];
+    const std::size_t size = expected.local_size * sizeof(Number);
+
+    const bool compressed =
+        header.codec != static_cast<std::uint32_t>(Codec::none);
+    AssertThrow(compressed || payload_size == size,
+                dealii::ExcMessage("Corrupted checkpoint " + name));
+
+    std::vector<char> buffer(compressed ? payload_size : 0);
+    const auto bytes =
+        compressed ? buffer.data() : reinterpret_cast<char *>(U.begin());
+
+    constexpr std::size_t max_chunk = std::size_t(1) << 30;
+    const std::uint64_t n_rounds = dealii::Utilities::MPI::max<std::uint64_t>(
+        (payload_size + max_chunk - 1) / max_chunk, mpi_communicator);
+
+    for (std::uint64_t round = 0; round < n_rounds; ++round) {
+      const std::size_t begin =
+          std::min<std::size_t>(payload_size, round * max_chunk);
+      const std::size_t count = std::min(payload_size - begin, max_chunk);
+      ierr = MPI_File_read_at_all(file,
+                                  payload_begin + begin,
+                                  bytes + begin,
+                                  count,
+                                  MPI_BYTE,
+                                  MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+
+    ierr = MPI_File_close(&file);
+    AssertThrowMPI(ierr);
+
+    if (compressed)
+      decompress(buffer.data(),
+                 buffer.size(),
+                 U.begin(),
+                 expected.local_size,
+                 omp_get_max_threads());
+
+    /*
+     * Every rank verifies its own slice. Reduce the result such that all
+     * ranks throw consistently:
+     */
+    const std::uint64_t checksum = checkpoint_checksum(U.begin(), size);
+    const unsigned int n_mismatches = dealii::Utilities::MPI::sum(
+        checksum == entry[2] ? 0u : 1u, mpi_communicator);
+    const std::uint64_t global_checksum =
+        dealii::Utilities::MPI::sum<std::uint64_t>(checksum, mpi_communicator);
+    AssertThrow(n_mismatches == 0 && global_checksum == header.checksum,
+                dealii::ExcMessage("Checksum mismatch in checkpoint " + name));
+
+    t = header.t;
+    output_cycle = header.output_cycle;
+
+    U.update_ghost_values();
   }
 } // namespace ryujin
 
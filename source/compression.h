@@ -0,0 +1,523 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 by the ryujin authors
+//
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include "openmp.h"
+
+#include <deal.II/base/exceptions.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * @name Compression of floating point fields
+   *
+   * Self-contained codecs for the compression of checkpoints and raw
+   * field output. A field of @p n values with @p n_comp interleaved
+   * components (see MultiComponentVector) is split into blocks that are
+   * compressed independently (and in parallel). Every block is
+   * transformed such that smooth fields result in long runs of zero
+   * bytes, which are then removed by a zero run-length encoding:
+   *
+   *  - Codec::xor_shuffle (lossless): Every value is XORed with the
+   *    previous value of the same component. Bytes are then shuffled,
+   *    i.e., all bytes of the same significance are stored contiguously.
+   *
+   *  - Codec::quantize (lossy): Every value is quantized to an integer
+   *    multiple of 2 * tolerance, i.e., with an absolute error of at most
+   *    tolerance. The difference to the previous quantized value of the
+   *    same component is then stored as a (zigzag encoded) integer and
+   *    byte shuffled. Intended for visualization-only output.
+   *
+   *    The decompressed value is the quantized value rounded to the
+   *    floating point type. The absolute error of a value x is thus
+   *    bounded by tolerance + eps |x| (with eps the machine epsilon of
+   *    the floating point type) instead of tolerance. Both bounds only
+   *    differ if tolerance is close to or below the spacing of floating
+   *    point numbers around x.
+   */
+  //@{
+
+  /**
+   * Available codecs.
+   *
+   * @ingroup Miscellaneous
+   */
+  enum class Codec : std::uint32_t {
+    /**
+     * No compression.
+     */
+    none = 0,
+
+    /**
+     * Lossless XOR-delta and byte shuffling.
+     */
+    xor_shuffle = 1,
+
+    /**
+     * Bounded-error quantization.
+     */
+    quantize = 2,
+  };
+
+
+  /**
+   * Translate the run time parameter strings "none", "xor shuffle", and
+   * "quantize" into a Codec.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline Codec codec_from_string(const std::string &name)
+  {
+    if (name == "none")
+      return Codec::none;
+    else if (name == "xor shuffle")
+      return Codec::xor_shuffle;
+    else if (name == "quantize")
+      return Codec::quantize;
+
+    AssertThrow(false, dealii::ExcMessage("Unknown codec \"" + name + "\""));
+    return Codec::none;
+  }
+
+
+  /**
+   * Statistics of a compression operation.
+   *
+   * @ingroup Miscellaneous
+   */
+  struct CompressionStatistics {
+    std::uint64_t uncompressed_size = 0;
+    std::uint64_t compressed_size = 0;
+    double seconds = 0.;
+  };
+
+
+  namespace internal
+  {
+    /* Target number of values per block: */
+    constexpr std::size_t compression_block_size = std::size_t(1) << 17;
+
+    inline void write_varint(std::uint64_t value, std::vector<char> &out)
+    {
+      while (value >= 0x80) {
+        out.push_back(char((value & 0x7f) | 0x80));
+        value >>= 7;
+      }
+      out.push_back(char(value));
+    }
+
+    inline std::uint64_t read_varint(const unsigned char *&in,
+                                     const unsigned char *end)
+    {
+      std::uint64_t value = 0;
+      for (unsigned int shift = 0; shift < 64; shift += 7) {
+        AssertThrow(in < end,
+                    dealii::ExcMessage("Corrupted compressed stream"));
+        const unsigned char byte = *in++;
+        value |= std::uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+          return value;
+      }
+      AssertThrow(false, dealii::ExcMessage("Corrupted compressed stream"));
+      return value;
+    }
+
+    /*
+     * Zero run-length encoding: A sequence of records consisting of a
+     * literal count, the literal bytes, and a count of zero bytes.
+     */
+    inline void zero_rle_encode(const unsigned char *in,
+                                const std::size_t n,
+                                std::vector<char> &out)
+    {
+      std::size_t literal_begin = 0;
+      std::size_t i = 0;
+      while (i < n) {
+        if (in[i] != 0) {
+          ++i;
+          continue;
+        }
+
+        std::size_t j = i;
+        while (j < n && in[j] == 0)
+          ++j;
+
+        /* Short runs of zeros are cheaper to store as literals: */
+        if (j - i < 4 && j != n) {
+          i = j;
+          continue;
+        }
+
+        write_varint(i - literal_begin, out);
+        out.insert(out.end(), in + literal_begin, in + i);
+        write_varint(j - i, out);
+        literal_begin = i = j;
+      }
+
+      if (literal_begin < n) {
+        write_varint(n - literal_begin, out);
+        out.insert(out.end(), in + literal_begin, in + n);
+        write_varint(0, out);
+      }
+    }
+
+    inline void zero_rle_decode(const unsigned char *in,
+                                const std::size_t size,
+                                unsigned char *out,
+                                const std::size_t n)
+    {
+      const unsigned char *end = in + size;
+      std::size_t k = 0;
+      while (in < end) {
+        const auto n_literals = read_varint(in, end);
+        AssertThrow(n_literals <= std::size_t(end - in) &&
+                        n_literals <= n - k,
+                    dealii::ExcMessage("Corrupted compressed stream"));
+        std::memcpy(out + k, in, n_literals);
+        in += n_literals;
+        k += n_literals;
+
+        const auto n_zeros = read_varint(in, end);
+        AssertThrow(n_zeros <= n - k,
+                    dealii::ExcMessage("Corrupted compressed stream"));
+        std::memset(out + k, 0, n_zeros);
+        k += n_zeros;
+      }
+      AssertThrow(k == n, dealii::ExcMessage("Corrupted compressed stream"));
+    }
+
+    /*
+     * Store byte b of word k at position b * n_words + k:
+     */
+    template <typename Word>
+    void shuffle(const Word *words,
+                 const std::size_t n_words,
+                 unsigned char *out)
+    {
+      for (std::size_t k = 0; k < n_words; ++k) {
+        unsigned char bytes[sizeof(Word)];
+        std::memcpy(bytes, words + k, sizeof(Word));
+        for (std::size_t b = 0; b < sizeof(Word); ++b)
+          out[b * n_words + k] = bytes[b];
+      }
+    }
+
+    template <typename Word>
+    void unshuffle(const unsigned char *in,
+                   const std::size_t n_words,
+                   Word *words)
+    {
+      for (std::size_t k = 0; k < n_words; ++k) {
+        unsigned char bytes[sizeof(Word)];
+        for (std::size_t b = 0; b < sizeof(Word); ++b)
+          bytes[b] = in[b * n_words + k];
+        std::memcpy(words + k, bytes, sizeof(Word));
+      }
+    }
+
+    /* Unsigned integer type of the same size as Number: */
+    template <typename Number>
+    using word_type = std::conditional_t<sizeof(Number) == 8,
+                                         std::uint64_t,
+                                         std::uint32_t>;
+
+    /*
+     * Transform a block of n values into words that are (mostly) small
+     * for smooth fields:
+     */
+    template <typename Number>
+    void encode_block(const Codec codec,
+                      const Number *values,
+                      const std::size_t n,
+                      const unsigned int n_comp,
+                      const double tolerance,
+                      std::vector<char> &out)
+    {
+      std::vector<unsigned char> shuffled;
+
+      if (codec == Codec::xor_shuffle) {
+        using Word = word_type<Number>;
+        std::vector<Word> words(n);
+        std::memcpy(words.data(), values, n * sizeof(Number));
+        for (std::size_t k = n; k-- > n_comp;)
+          words[k] ^= words[k - n_comp];
+
+        shuffled.resize(n * sizeof(Word));
+        shuffle(words.data(), n, shuffled.data());
+
+      } else {
+        Assert(codec == Codec::quantize, dealii::ExcInternalError());
+
+        const double factor = 0.5 / tolerance;
+        std::vector<std::int64_t> quantized(n);
+        for (std::size_t k = 0; k < n; ++k) {
+          const double scaled = double(values[k]) * factor;
+          AssertThrow(std::abs(scaled) < 4.e18, dealii::ExcInternalError());
+          quantized[k] = std::llround(scaled);
+        }
+
+        std::vector<std::uint64_t> words(n);
+        for (std::size_t k = 0; k < n; ++k) {
+          const std::int64_t delta =
+              k < n_comp ? quantized[k] : quantized[k] - quantized[k - n_comp];
+          /* zigzag encoding: */
+          words[k] = (std::uint64_t(delta) << 1) ^ std::uint64_t(delta >> 63);
+        }
+
+        shuffled.resize(n * sizeof(std::uint64_t));
+        shuffle(words.data(), n, shuffled.data());
+      }
+
+      zero_rle_encode(shuffled.data(), shuffled.size(), out);
+    }
+
+    template <typename Number>
+    void decode_block(const Codec codec,
+                      const unsigned char *in,
+                      const std::size_t size,
+                      Number *values,
+                      const std::size_t n,
+                      const unsigned int n_comp,
+                      const double tolerance)
+    {
+      if (codec == Codec::xor_shuffle) {
+        using Word = word_type<Number>;
+        std::vector<unsigned char> shuffled(n * sizeof(Word));
+        zero_rle_decode(in, size, shuffled.data(), shuffled.size());
+
+        std::vector<Word> words(n);
+        unshuffle(shuffled.data(), n, words.data());
+        for (std::size_t k = n_comp; k < n; ++k)
+          words[k] ^= words[k - n_comp];
+
+        std::memcpy(values, words.data(), n * sizeof(Number));
+
+      } else {
+        AssertThrow(codec == Codec::quantize,
+                    dealii::ExcMessage("Corrupted compressed stream"));
+
+        std::vector<unsigned char> shuffled(n * sizeof(std::uint64_t));
+        zero_rle_decode(in, size, shuffled.data(), shuffled.size());
+
+        std::vector<std::uint64_t> words(n);
+        unshuffle(shuffled.data(), n, words.data());
+
+        std::vector<std::int64_t> quantized(n);
+        for (std::size_t k = 0; k < n; ++k) {
+          const std::int64_t delta =
+              std::int64_t(words[k] >> 1) ^ -std::int64_t(words[k] & 1);
+          quantized[k] = k < n_comp ? delta : quantized[k - n_comp] + delta;
+        }
+
+        const double step = 2. * tolerance;
+        for (std::size_t k = 0; k < n; ++k)
+          values[k] = Number(double(quantized[k]) * step);
+      }
+    }
+
+    /*
+     * Header of a compressed stream:
+     */
+    struct StreamHeader {
+      std::uint32_t codec;
+      std::uint32_t n_comp;
+      double tolerance;
+      std::uint64_t n_values;
+      std::uint64_t n_blocks;
+    };
+
+    static_assert(sizeof(StreamHeader) == 32,
+                  "StreamHeader must not contain padding");
+  } // namespace internal
+
+
+  /**
+   * Compress @p n values stored at @p data consisting of @p n_comp
+   * interleaved components with @p codec and return the compressed
+   * stream. The stream is self-describing, i.e., decompress() only
+   * requires the number of values. @p tolerance is the maximal absolute
+   * quantization error of Codec::quantize (up to the rounding of the
+   * result, see above) and ignored otherwise. Blocks are
+   * compressed in parallel with @p n_threads OpenMP threads.
+   *
+   * If @p statistics is not a null pointer, the sizes and the wall time
+   * of the operation are added to it.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <typename Number>
+  std::vector<char> compress(const Codec codec,
+                             const Number *data,
+                             const std::size_t n,
+                             const unsigned int n_comp,
+                             const double tolerance,
+                             const unsigned int n_threads,
+                             CompressionStatistics *statistics = nullptr)
+  {
+    static_assert(std::is_floating_point<Number>::value,
+                  "compress() requires a floating point type");
+    AssertThrow(codec != Codec::quantize || tolerance > 0.,
+                dealii::ExcMessage("Quantization requires a positive "
+                                   "tolerance"));
+
+    const auto time_begin = std::chrono::steady_clock::now();
+
+    /* Blocks start at a value of the first component: */
+    const std::size_t block_size = std::max<std::size_t>(
+        internal::compression_block_size / n_comp * n_comp, n_comp);
+    const std::size_t n_blocks = (n + block_size - 1) / block_size;
+
+    std::vector<std::vector<char>> blocks(n_blocks);
+
+    /*
+     * Exceptions must not leave an OpenMP region. Record failing blocks
+     * and throw afterwards:
+     */
+    std::vector<char> failed(n_blocks, 0);
+
+    RYUJIN_PRAGMA(omp parallel for schedule(dynamic) num_threads(n_threads))
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+      const std::size_t begin = b * block_size;
+      const std::size_t end = std::min(n, begin + block_size);
+      try {
+        internal::encode_block(
+            codec, data + begin, end - begin, n_comp, tolerance, blocks[b]);
+      } catch (...) {
+        failed[b] = 1;
+      }
+    }
+
+    AssertThrow(std::find(failed.begin(), failed.end(), 1) == failed.end(),
+                dealii::ExcMessage("Value out of range for quantization with "
+                                   "the chosen tolerance"));
+
+    internal::StreamHeader header;
+    header.codec = static_cast<std::uint32_t>(codec);
+    header.n_comp = n_comp;
+    header.tolerance = tolerance;
+    header.n_values = n;
+    header.n_blocks = n_blocks;
+
+    std::size_t size = sizeof(header) + n_blocks * sizeof(std::uint64_t);
+    for (const auto &block : blocks)
+      size += block.size();
+
+    std::vector<char> result(size);
+    char *out = result.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    for (const auto &block : blocks) {
+      const std::uint64_t block_bytes = block.size();
+      std::memcpy(out, &block_bytes, sizeof(block_bytes));
+      out += sizeof(block_bytes);
+    }
+    for (const auto &block : blocks) {
+      std::memcpy(out, block.data(), block.size());
+      out += block.size();
+    }
+
+    if (statistics != nullptr) {
+      statistics->uncompressed_size += n * sizeof(Number);
+      statistics->compressed_size += size;
+      statistics->seconds += std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - time_begin)
+                                 .count();
+    }
+
+    return result;
+  }
+
+
+  /**
+   * Decompress a stream [@p data, @p data + @p size) created by
+   * compress() into @p n values stored at @p out. Blocks are
+   * decompressed in parallel with @p n_threads OpenMP threads. The
+   * function throws an exception if the stream is corrupted or does not
+   * contain @p n values.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <typename Number>
+  void decompress(const char *data,
+                  const std::size_t size,
+                  Number *out,
+                  const std::size_t n,
+                  const unsigned int n_threads)
+  {
+    internal::StreamHeader header;
+    AssertThrow(size >= sizeof(header),
+                dealii::ExcMessage("Corrupted compressed stream"));
+    std::memcpy(&header, data, sizeof(header));
+
+    AssertThrow(header.n_values == n && header.n_comp > 0 &&
+                    size >= sizeof(header) +
+                                header.n_blocks * sizeof(std::uint64_t),
+                dealii::ExcMessage("Corrupted compressed stream"));
+
+    const auto codec = static_cast<Codec>(header.codec);
+    const unsigned int n_comp = header.n_comp;
+    const std::size_t block_size = std::max<std::size_t>(
+        internal::compression_block_size / n_comp * n_comp, n_comp);
+    AssertThrow(header.n_blocks == (n + block_size - 1) / block_size,
+                dealii::ExcMessage("Corrupted compressed stream"));
+
+    /* Determine the position of every block in the stream: */
+    std::vector<std::uint64_t> offsets(header.n_blocks + 1);
+    offsets[0] = sizeof(header) + header.n_blocks * sizeof(std::uint64_t);
+    for (std::size_t b = 0; b < header.n_blocks; ++b) {
+      std::uint64_t block_bytes;
+      std::memcpy(&block_bytes,
+                  data + sizeof(header) + b * sizeof(std::uint64_t),
+                  sizeof(block_bytes));
+      offsets[b + 1] = offsets[b] + block_bytes;
+    }
+    AssertThrow(offsets.back() == size,
+                dealii::ExcMessage("Corrupted compressed stream"));
+
+    const auto bytes = reinterpret_cast<const unsigned char *>(data);
+
+    /*
+     * Exceptions must not leave an OpenMP region. Record failing blocks
+     * and throw afterwards:
+     */
+    std::vector<char> failed(header.n_blocks, 0);
+
+    RYUJIN_PRAGMA(omp parallel for schedule(dynamic) num_threads(n_threads))
+    for (std::size_t b = 0; b < header.n_blocks; ++b) {
+      const std::size_t begin = b * block_size;
+      const std::size_t end = std::min(n, begin + block_size);
+      try {
+        internal::decode_block(codec,
+                               bytes + offsets[b],
+                               offsets[b + 1] - offsets[b],
+                               out + begin,
+                               end - begin,
+                               n_comp,
+                               header.tolerance);
+      } catch (...) {
+        failed[b] = 1;
+      }
+    }
+
+    AssertThrow(std::find(failed.begin(), failed.end(), 1) == failed.end(),
+                dealii::ExcMessage("Corrupted compressed stream"));
+  }
+
+  //@}
+
+} // namespace ryujin
+
+#endif /* COMPRESSION_H */
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <set>
+#include <string>
 
 namespace ryujin
 {
@@ -115,8 +116,14 @@ namespace ryujin
     /**
      * Create the triangulation and set up the finite element, mapping and
      * quadrature objects.
+     *
+     * If @p archive_name is nonempty the refined mesh is not created by
+     * global refinement but loaded (and partitioned over the current
+     * number of MPI ranks) from an archive written with
+     * dealii::parallel::distributed::Triangulation::save(), see
+     * do_checkpoint_repartitionable().
      */
-    void prepare();
+    void prepare(const std::string &archive_name = "");
 
   protected:
     const MPI_Comm &mpi_communicator_;
@@ -158,7 +165,6 @@ namespace ryujin
     double mesh_distortion_;
 
     unsigned int refinement_;
-    bool repartitioning_;
 
     unsigned int order_finite_element_;
     unsigned int order_mapping_;
@@ -0,0 +1,346 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 by the ryujin authors
+//
+
+#ifndef EDGE_LIST_SIMD_H
+#define EDGE_LIST_SIMD_H
+
+#include <compile_time_options.h>
+
+#include "sparse_matrix_simd.h"
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+namespace ryujin
+{
+  /**
+   * A list of all unique edges \f$(i,j)\f$, \f$i<j\f$, of a local
+   * SparsityPatternSIMD for which the row index \f$i\f$ is locally owned.
+   * Local numbering.
+   *
+   * For every edge we record the two indices \f$i\f$ and \f$j\f$, the
+   * position of \f$j\f$ within row \f$i\f$, the position of \f$i\f$ within
+   * row \f$j\f$ (if \f$j\f$ is locally owned), and, with
+   * USE_PRECOMPUTED_NORMALS, the norm \f$|c_{ij}|\f$ and unit normal
+   * \f$n_{ij}=c_{ij}/|c_{ij}|\f$. Edges are sorted by row index. The unit
+   * normals are stored in the same array-of-struct-of-array layout used
+   * in SparseMatrixSIMD, i.e., the components of simd_length consecutive
+   * edges are grouped contiguously in memory. Without
+   * USE_PRECOMPUTED_NORMALS, \f$c_{ij}\f$ has to be loaded from the
+   * \f$c_{ij}\f$ matrix at position_in_row() instead.
+   *
+   * In addition we maintain a (short) list of "boundary edges", i.e.,
+   * edges for which both \f$i\f$ and \f$j\f$ are boundary degrees of
+   * freedom and for which \f$c_{ji}\neq-c_{ij}\f$ in general. For those we
+   * additionally store \f$c_{ji}\f$.
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number,
+            int dim,
+            int simd_length = dealii::VectorizedArray<Number>::size()>
+  class EdgeListSIMD
+  {
+  public:
+    using VectorizedArray = dealii::VectorizedArray<Number, simd_length>;
+
+    EdgeListSIMD();
+
+    /**
+     * Populate the edge list from the given sparsity pattern and
+     * \f$c_{ij}\f$ matrix. The @p boundary_map is only queried with
+     * count() to determine whether a given index is situated at the
+     * boundary.
+     */
+    template <typename Number2, typename BoundaryMap>
+    void reinit(
+        const unsigned int n_locally_owned,
+        const SparsityPatternSIMD<simd_length> &sparsity,
+        const SparseMatrixSIMD<Number, dim, simd_length, Number2> &cij_matrix,
+        const BoundaryMap &boundary_map);
+
+    unsigned int n_edges() const;
+
+    const unsigned int *rows(const unsigned int edge) const;
+
+    const unsigned int *columns(const unsigned int edge) const;
+
+    unsigned int position_in_row(const unsigned int edge) const;
+
+    unsigned int position_in_column(const unsigned int edge) const;
+
+#ifdef USE_PRECOMPUTED_NORMALS
+    Number get_norm(const unsigned int edge) const;
+
+    VectorizedArray get_vectorized_norm(const unsigned int edge) const;
+
+    dealii::Tensor<1, dim, Number> get_normal(const unsigned int edge) const;
+
+    dealii::Tensor<1, dim, VectorizedArray>
+    get_vectorized_normal(const unsigned int edge) const;
+#endif
+
+    unsigned int n_boundary_edges() const;
+
+    unsigned int boundary_edge(const unsigned int k) const;
+
+    const dealii::Tensor<1, dim, Number> &
+    get_boundary_cji(const unsigned int k) const;
+
+  private:
+    unsigned int n_edges_;
+
+    dealii::AlignedVector<unsigned int> rows_;
+    dealii::AlignedVector<unsigned int> columns_;
+    dealii::AlignedVector<unsigned int> positions_;
+#ifdef USE_PRECOMPUTED_NORMALS
+    dealii::AlignedVector<Number> norms_;
+    dealii::AlignedVector<Number> normals_;
+#endif
+
+    std::vector<unsigned int> boundary_edges_;
+    std::vector<dealii::Tensor<1, dim, Number>> boundary_cji_;
+  };
+
+
+  template <typename Number, int dim, int simd_length>
+  EdgeListSIMD<Number, dim, simd_length>::EdgeListSIMD()
+      : n_edges_(0)
+  {
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  template <typename Number2, typename BoundaryMap>
+  void EdgeListSIMD<Number, dim, simd_length>::reinit(
+      const unsigned int n_locally_owned,
+      const SparsityPatternSIMD<simd_length> &sparsity,
+      const SparseMatrixSIMD<Number, dim, simd_length, Number2> &cij_matrix,
+      const BoundaryMap &boundary_map)
+  {
+    /* First pass: count edges: */
+
+    n_edges_ = 0;
+    for (unsigned int i = 0; i < n_locally_owned; ++i) {
+      const unsigned int stride = sparsity.stride_of_row(i);
+      const unsigned int row_length = sparsity.row_length(i);
+      const unsigned int *js = sparsity.columns(i);
+      for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx)
+        if (js[col_idx * stride] > i)
+          ++n_edges_;
+    }
+
+    rows_.resize(n_edges_);
+    columns_.resize(n_edges_);
+    positions_.resize(2 * n_edges_);
+#ifdef USE_PRECOMPUTED_NORMALS
+    const unsigned int n_padded =
+        (n_edges_ + simd_length - 1) / simd_length * simd_length;
+    norms_.resize(n_padded);
+    normals_.resize(n_padded * dim);
+#endif
+
+    boundary_edges_.clear();
+    boundary_cji_.clear();
+
+    /* Second pass: populate: */
+
+    unsigned int edge = 0;
+    for (unsigned int i = 0; i < n_locally_owned; ++i) {
+      const unsigned int stride_i = sparsity.stride_of_row(i);
+      const unsigned int row_length_i = sparsity.row_length(i);
+      const unsigned int *js = sparsity.columns(i);
+
+      for (unsigned int col_idx = 1; col_idx < row_length_i; ++col_idx) {
+        const unsigned int j = js[col_idx * stride_i];
+        if (j <= i)
+          continue;
+
+        rows_[edge] = i;
+        columns_[edge] = j;
+        positions_[2 * edge] = col_idx;
+        positions_[2 * edge + 1] = dealii::numbers::invalid_unsigned_int;
+
+        /* Only record the transposed position for locally owned rows: */
+        if (j < n_locally_owned) {
+          const unsigned int stride_j = sparsity.stride_of_row(j);
+          const unsigned int row_length_j = sparsity.row_length(j);
+          const unsigned int *is = sparsity.columns(j);
+          for (unsigned int col_jdx = 1; col_jdx < row_length_j; ++col_jdx)
+            if (is[col_jdx * stride_j] == i) {
+              positions_[2 * edge + 1] = col_jdx;
+              break;
+            }
+          Assert(positions_[2 * edge + 1] !=
+                     dealii::numbers::invalid_unsigned_int,
+                 dealii::ExcMessage("Sparsity pattern is not symmetric"));
+        }
+
+#ifdef USE_PRECOMPUTED_NORMALS
+        const auto c_ij = cij_matrix.get_tensor(i, col_idx);
+        const Number norm = c_ij.norm();
+        norms_[edge] = norm;
+        Number *pos = normals_.data() +
+                      edge / simd_length * simd_length * dim +
+                      edge % simd_length;
+        for (unsigned int d = 0; d < dim; ++d)
+          pos[d * simd_length] = norm != Number(0.) ? c_ij[d] / norm : 0.;
+#endif
+
+        if (boundary_map.count(i) != 0 && boundary_map.count(j) != 0) {
+          boundary_edges_.push_back(edge);
+          boundary_cji_.push_back(
+              cij_matrix.get_transposed_tensor(i, col_idx));
+        }
+
+        ++edge;
+      }
+    }
+
+    Assert(edge == n_edges_, dealii::ExcInternalError());
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  EdgeListSIMD<Number, dim, simd_length>::n_edges() const
+  {
+    return n_edges_;
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  EdgeListSIMD<Number, dim, simd_length>::rows(const unsigned int edge) const
+  {
+    AssertIndexRange(edge, n_edges_);
+    return rows_.data() + edge;
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  EdgeListSIMD<Number, dim, simd_length>::columns(
+      const unsigned int edge) const
+  {
+    AssertIndexRange(edge, n_edges_);
+    return columns_.data() + edge;
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  EdgeListSIMD<Number, dim, simd_length>::position_in_row(
+      const unsigned int edge) const
+  {
+    AssertIndexRange(edge, n_edges_);
+    return positions_[2 * edge];
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  EdgeListSIMD<Number, dim, simd_length>::position_in_column(
+      const unsigned int edge) const
+  {
+    AssertIndexRange(edge, n_edges_);
+    return positions_[2 * edge + 1];
+  }
+
+
+#ifdef USE_PRECOMPUTED_NORMALS
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline Number
+  EdgeListSIMD<Number, dim, simd_length>::get_norm(
+      const unsigned int edge) const
+  {
+    AssertIndexRange(edge, n_edges_);
+    return norms_[edge];
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline dealii::VectorizedArray<Number, simd_length>
+  EdgeListSIMD<Number, dim, simd_length>::get_vectorized_norm(
+      const unsigned int edge) const
+  {
+    AssertIndexRange(edge + simd_length - 1, n_edges_);
+    Assert(edge % simd_length == 0,
+           dealii::ExcMessage(
+               "Access only supported for edges at the SIMD granularity"));
+
+    VectorizedArray result;
+    result.load(norms_.data() + edge);
+    return result;
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, dim, Number>
+  EdgeListSIMD<Number, dim, simd_length>::get_normal(
+      const unsigned int edge) const
+  {
+    AssertIndexRange(edge, n_edges_);
+
+    dealii::Tensor<1, dim, Number> result;
+    const Number *pos = normals_.data() +
+                        edge / simd_length * simd_length * dim +
+                        edge % simd_length;
+    for (unsigned int d = 0; d < dim; ++d)
+      result[d] = pos[d * simd_length];
+    return result;
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline auto
+  EdgeListSIMD<Number, dim, simd_length>::get_vectorized_normal(
+      const unsigned int edge) const -> dealii::Tensor<1, dim, VectorizedArray>
+  {
+    AssertIndexRange(edge + simd_length - 1, n_edges_);
+    Assert(edge % simd_length == 0,
+           dealii::ExcMessage(
+               "Access only supported for edges at the SIMD granularity"));
+
+    dealii::Tensor<1, dim, VectorizedArray> result;
+    const Number *load_pos = normals_.data() + edge * dim;
+    for (unsigned int d = 0; d < dim; ++d)
+      result[d].load(load_pos + d * simd_length);
+    return result;
+  }
+#endif
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  EdgeListSIMD<Number, dim, simd_length>::n_boundary_edges() const
+  {
+    return boundary_edges_.size();
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  EdgeListSIMD<Number, dim, simd_length>::boundary_edge(
+      const unsigned int k) const
+  {
+    AssertIndexRange(k, boundary_edges_.size());
+    return boundary_edges_[k];
+  }
+
+
+  template <typename Number, int dim, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const dealii::Tensor<1, dim, Number> &
+  EdgeListSIMD<Number, dim, simd_length>::get_boundary_cji(
+      const unsigned int k) const
+  {
+    AssertIndexRange(k, boundary_cji_.size());
+    return boundary_cji_[k];
+  }
+
+} // namespace ryujin
+
+#endif /* EDGE_LIST_SIMD_H */
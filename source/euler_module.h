@@ -9,6 +9,8 @@
 #include <compile_time_options.h>
 
 #include "convenience_macros.h"
+#include "halo_exchange.h"
+#include "openmp.h"
 #include "simd.h"
 
 #include "limiter.h"
@@ -24,6 +26,9 @@
 #include <deal.II/lac/sparse_matrix.templates.h>
 #include <deal.II/lac/vector.h>
 
+#include <array>
+#include <deque>
+
 namespace ryujin
 {
   /**
@@ -74,7 +79,7 @@ namespace ryujin
     };
 
     /**
-     * An enum for the approximation order in space.
+     * An enum for the approximation order in time.
      */
     enum class TimeStepOrder {
       /** Perform a first-order explicit Euler step. */
@@ -82,7 +87,13 @@ namespace ryujin
       /** Perform an SSP-RK2 step (Heun's method). */
       second_order,
       /** Perform an SSP-RK3 step (Third order Runge-Kutta method). */
-      third_order
+      third_order,
+      /** Perform an SSPRK(4,3) step (SSP coefficient 2). */
+      third_order_four_stages,
+      /** Perform an SSPRK(5,3) step (SSP coefficient 2.65). */
+      third_order_five_stages,
+      /** Perform an SSPRK(10,4) step (SSP coefficient 6). */
+      fourth_order_ten_stages
     };
 
     /**
@@ -137,12 +148,37 @@ namespace ryujin
      *  - returns the computed maximal time step size tau_max
      *
      *  - performs a time step and populates the vector U_new by the
-     *    result. The time step is performed with either tau_max (if tau ==
-     *    0), or tau (if tau != 0). Here, tau_max is the computed maximal
-     *    time step size and tau is the optional third parameter.
+     *    result. The time step is performed with either tau_factor() *
+     *    tau_max (if tau == 0), or tau (if tau != 0). Here, tau_max is the
+     *    computed maximal time step size and tau is the optional third
+     *    parameter. The scaling factor tau_factor() is set by the
+     *    predictive time-step controller of the multi-stage schemes and
+     *    is equal to one for TimeStepOrder::first_order.
      */
     Number euler_step(vector_type &U, Number t, Number tau = 0.);
 
+    /**
+     * Variant of above function that reads the state from @p U and stores
+     * the result in @p U_new. If @p U_old is not a nullptr the function
+     * stores the convex combination
+     * \f[
+     *   U_{\text{new}} = a\,U_{\text{old}} + b\,(U + \tau L(U))
+     * \f]
+     * instead. The combination is computed in the final update sweep and
+     * thus avoids additional passes over the state vectors in the SSP
+     * Runge Kutta schemes.
+     *
+     * @p U_new is only modified after the update has been computed, so it
+     * may refer to the same vector as @p U or @p U_old.
+     */
+    Number euler_step(const vector_type &U,
+                      vector_type &U_new,
+                      Number t,
+                      Number tau,
+                      const vector_type *U_old = nullptr,
+                      Number a = 0.,
+                      Number b = 1.);
+
     /**
      * Given a reference to a previous state vector U perform an explicit
      * Heun 2nd order step (and store the result in U).
@@ -163,19 +199,98 @@ namespace ryujin
      */
     Number ssprk3_step(vector_type &U, Number t);
 
+    /**
+     * Given a reference to a previous state vector U perform an explicit
+     * four-stage SSP Runge Kutta 3rd order step with SSP coefficient 2
+     * (and store the result in U). Every stage is an explicit Euler step
+     * with half the time step size. Low-storage implementation that only
+     * uses U and one temporary vector.
+     *
+     *  - returns the chosen time step size tau
+     *
+     * See @cite Ketcheson2008, Section 6.2.
+     */
+    Number ssprk43_step(vector_type &U, Number t);
+
+    /**
+     * Given a reference to a previous state vector U perform an explicit
+     * five-stage SSP Runge Kutta 3rd order step with SSP coefficient
+     * 2.65 (and store the result in U).
+     *
+     *  - returns the chosen time step size tau
+     *
+     * See @cite SpiteriRuuth2002.
+     */
+    Number ssprk53_step(vector_type &U, Number t);
+
+    /**
+     * Given a reference to a previous state vector U perform an explicit
+     * ten-stage SSP Runge Kutta 4th order step with SSP coefficient 6
+     * (and store the result in U). Every stage is an explicit Euler step
+     * with a sixth of the time step size.
+     *
+     *  - returns the chosen time step size tau
+     *
+     * See @cite Ketcheson2008, Section 6.3.
+     */
+    Number ssprk104_step(vector_type &U, Number t);
+
     /**
      * Given a reference to a previous state vector U perform an explicit
      * time step (and store the result in U). The function returns the
      * chosen time step size tau.
      *
-     * This function switches between euler_step(), ssph2_step(), or
-     * ssprk3_step() depending on selected approximation order.
+     * This function switches between euler_step(), ssph2_step(),
+     * ssprk3_step(), ssprk43_step(), ssprk53_step(), or ssprk104_step()
+     * depending on selected approximation order.
      */
     Number step(vector_type &U, Number t);
 
     //@}
 
   private:
+    /**
+     * @name Predictive time-step controller
+     *
+     * A restart of a multi-stage SSP step discards all stages computed so
+     * far. In order to make restarts rare we record for every step the
+     * smallest ratio of the maximal admissible step size of a later stage
+     * to the maximal step size of the first stage. The first stage of the
+     * next step then uses the maximal step size scaled by the minimum of
+     * these ratios over a short history. The scaling factor is allowed to
+     * grow back to one by at most a fixed factor per step.
+     */
+    //@{
+
+    /**
+     * Reset the controller state at the beginning of a step.
+     */
+    void begin_step();
+
+    /**
+     * Given the maximal admissible step size @p tau_max computed in the
+     * first stage return the step size to use for all stages. If @p tau_0
+     * is nonzero (i.e., the step has been restarted) @p tau_0 is
+     * returned.
+     */
+    Number propose_tau(const Number tau_max, const Number tau_0);
+
+    /**
+     * Check whether the maximal admissible step size @p tau_max computed
+     * in a later stage is sufficient for the chosen step size @p tau. If
+     * not, update the restart statistics, set @p tau_0 to @p tau_max and
+     * return true.
+     */
+    bool
+    restart_required(const Number tau_max, const Number tau, Number &tau_0);
+
+    /**
+     * Record the ratios of the current step in the history and update
+     * the scaling factor for the next step.
+     */
+    void accept_step();
+
+    //@}
     /**
      * @name Run time options
      */
@@ -184,6 +299,16 @@ namespace ryujin
     Number cfl_update_;
     Number cfl_max_;
 
+    unsigned int tau_controller_history_;
+    Number tau_controller_growth_;
+    Number tau_controller_safety_;
+
+    unsigned int scheduling_chunks_per_thread_;
+
+    bool temporal_blocking_;
+
+    bool early_halo_sends_;
+
     //@}
     /**
      * @name Internal data
@@ -200,6 +325,67 @@ namespace ryujin
     unsigned int n_restarts_;
     ACCESSOR_READ_ONLY(n_restarts)
 
+    unsigned int n_wasted_stages_;
+    ACCESSOR_READ_ONLY(n_wasted_stages)
+
+    double wasted_time_;
+    ACCESSOR_READ_ONLY(wasted_time)
+
+    Number tau_factor_;
+    ACCESSOR_READ_ONLY(tau_factor)
+
+    /* Controller state of the current step: */
+    Number tau_max_first_stage_;
+    Number tau_ratio_;
+    unsigned int n_stages_;
+    dealii::Timer attempt_timer_;
+
+    std::deque<Number> tau_ratio_history_;
+
+    /*
+     * Per-thread busy and idle times (spent in barriers and waiting for
+     * block dependencies) of Step 0 to Step 4, and of all high-order
+     * passes (index 5) of euler_step():
+     */
+    std::array<LoadBalanceStatistics, 6> load_balance_statistics_;
+    ACCESSOR_READ_ONLY(load_balance_statistics)
+
+    /*
+     * Row blocks for the dataflow execution of euler_step(). Block b
+     * consists of the rows [block_starts_[b], block_starts_[b + 1]). The
+     * blocks [0, n_blocks_simd_) partition the vectorized range,
+     * [n_blocks_simd_, n_blocks_owned_) the remaining locally owned
+     * range, and all subsequent blocks the ghost range. For every locally
+     * owned block we store (in CSR format) all blocks containing a column
+     * index of one of its rows:
+     */
+    std::vector<unsigned int> block_starts_;
+    unsigned int n_blocks_simd_;
+    unsigned int n_blocks_owned_;
+    std::vector<unsigned int> block_dependency_starts_;
+    std::vector<unsigned int> block_dependencies_;
+    BlockProgress block_progress_;
+
+    /*
+     * For every locally owned block the length of the shortest path in
+     * the block dependency graph to a block with a ghost dependency. Set
+     * to the maximal representable value if no such path exists. Used
+     * for the temporally blocked execution of Step 3 to Step 4 +
+     * n_passes:
+     */
+    std::vector<unsigned int> block_distances_;
+
+    /*
+     * Partition of the export range into one chunk per neighboring MPI
+     * rank (import target of the scalar partitioner) for early halo
+     * sends. Work items are SIMD row groups in [0, n_internal) and
+     * individual rows in [n_internal, n_owned):
+     */
+    SynchronizationChunks export_chunks_;
+
+    /* Whether MPI supports concurrent calls from several threads: */
+    bool mpi_thread_multiple_;
+
     scalar_type alpha_;
     ACCESSOR_READ_ONLY(alpha)
 
@@ -207,18 +393,65 @@ namespace ryujin
     scalar_type specific_entropies_;
     scalar_type evc_entropies_;
 
+#ifdef USE_PRECOMPUTED_FLUXES
+    /* Node-wise flux, inverse density, pressure, and speed of sound: */
+    MultiComponentVector<
+        Number,
+        ProblemDescription<dim, Number>::n_precomputed_values>
+        precomputed_values_;
+#endif
+
     MultiComponentVector<Number, Limiter<dim, Number>::n_bounds> bounds_;
 
+#ifdef USE_PRECOMPUTED_NORMALS
+    /* Precomputed limiter relaxation radii r_i (locally owned only): */
+    scalar_type relaxation_radii_;
+#endif
+
     vector_type r_;
 
-    SparseMatrixSIMD<Number> dij_matrix_;
-    SparseMatrixSIMD<Number> lij_matrix_;
-    SparseMatrixSIMD<Number> lij_matrix_next_;
+    /*
+     * Number types used for storing the d_ij, l_ij, and p_ij matrices. If
+     * lower than Number we convert on load and store:
+     */
+#ifdef USE_MIXED_PRECISION
+    using dij_storage_type = float;
+#else
+    using dij_storage_type = Number;
+#endif
+
+#ifdef USE_MIXED_PRECISION_PIJ
+    using pij_storage_type = float;
+#else
+    using pij_storage_type = Number;
+#endif
+
+    static constexpr unsigned int simd_length_ =
+        dealii::VectorizedArray<Number>::size();
 
-    SparseMatrixSIMD<Number, problem_dimension> pij_matrix_;
+    SparseMatrixSIMD<Number, 1, simd_length_, dij_storage_type> dij_matrix_;
+    ACCESSOR_READ_ONLY(dij_matrix)
+
+    SparseMatrixSIMD<Number, 1, simd_length_, dij_storage_type> lij_matrix_;
+    SparseMatrixSIMD<Number, 1, simd_length_, dij_storage_type>
+        lij_matrix_next_;
+
+#ifndef RECOMPUTE_PIJ
+    SparseMatrixSIMD<Number, problem_dimension, simd_length_, pij_storage_type>
+        pij_matrix_;
+#endif
 
     vector_type temp_euler_;
     vector_type temp_ssp_;
+    vector_type temp_ssp_2_;
+
+    /*
+     * Persistent halo exchanges: alpha_ and second_variations_ (combined
+     * into a single message per neighbor), r_, and temp_euler_:
+     */
+    HaloExchange<Number> alpha_exchange_;
+    HaloExchange<Number> r_exchange_;
+    HaloExchange<Number> temp_euler_exchange_;
 
     //@}
   };
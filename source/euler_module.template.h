@@ -7,6 +7,7 @@
 #define EULER_MODULE_TEMPLATE_H
 
 #include "euler_module.h"
+#include "numa.h"
 #include "openmp.h"
 #include "scope.h"
 #include "simd.h"
@@ -14,7 +15,11 @@
 #include "indicator.h"
 #include "riemann_solver.h"
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
 
 #ifdef VALGRIND_CALLGRIND
 #include <valgrind/callgrind.h>
@@ -52,6 +57,11 @@ namespace ryujin
       , offline_data_(&offline_data)
       , initial_values_(&initial_values)
       , n_restarts_(0)
+      , n_wasted_stages_(0)
+      , wasted_time_(0.)
+      , tau_factor_(1.)
+      , n_blocks_simd_(0)
+      , n_blocks_owned_(0)
   {
     cfl_update_ = Number(0.95);
     add_parameter(
@@ -60,6 +70,48 @@ namespace ryujin
     cfl_max_ = Number(1.0);
     add_parameter(
         "cfl max", cfl_max_, "Maximal admissible relative CFL constant");
+
+    tau_controller_history_ = 10;
+    add_parameter("tau controller history",
+                  tau_controller_history_,
+                  "Number of steps the predictive time-step controller "
+                  "takes into account. Set to 0 to disable the controller");
+
+    tau_controller_growth_ = Number(1.02);
+    add_parameter("tau controller growth",
+                  tau_controller_growth_,
+                  "Maximal growth of the time-step scaling factor per step");
+
+    tau_controller_safety_ = Number(0.98);
+    add_parameter("tau controller safety",
+                  tau_controller_safety_,
+                  "Safety factor applied to the predicted time-step scaling "
+                  "factor");
+
+    scheduling_chunks_per_thread_ = 8;
+    add_parameter("scheduling chunks per thread",
+                  scheduling_chunks_per_thread_,
+                  "Number of row blocks per thread (and index range) the "
+                  "loops of an euler step are split into. If compiled with "
+                  "USE_DYNAMIC_SCHEDULING, blocks of about equal estimated "
+                  "cost are handed out dynamically");
+
+    temporal_blocking_ = false;
+    add_parameter("temporal blocking",
+                  temporal_blocking_,
+                  "Process row blocks away from the MPI halo through Step 3, "
+                  "Step 4, and all high-order passes in a staggered "
+                  "wavefront such that intermediate results are consumed "
+                  "while still residing in cache");
+
+    early_halo_sends_ = true;
+    add_parameter("early halo sends",
+                  early_halo_sends_,
+                  "Send the halo exchange message of Step 3, Step 4, and "
+                  "all high-order passes to every neighboring MPI rank as "
+                  "soon as all of its rows have been computed instead of "
+                  "waiting for all threads to leave the export range. Has "
+                  "no effect if compiled with USE_NEIGHBORHOOD_COLLECTIVES");
   }
 
 
@@ -70,20 +122,48 @@ namespace ryujin
     std::cout << "EulerModule<dim, Number>::prepare()" << std::endl;
 #endif
 
-    /* Initialize vectors: */
+    /*
+     * Initialize vectors. All vectors are first touched by the threads
+     * that later work on the corresponding rows, see
+     * reinit_first_touch():
+     */
+
+    const unsigned int n_internal = offline_data_->n_locally_internal();
+    const unsigned int n_owned = offline_data_->n_locally_owned();
 
     const auto &scalar_partitioner = offline_data_->scalar_partitioner();
-    second_variations_.reinit(scalar_partitioner);
-    alpha_.reinit(scalar_partitioner);
-    specific_entropies_.reinit(scalar_partitioner);
-    evc_entropies_.reinit(scalar_partitioner);
+    reinit_first_touch(
+        second_variations_, scalar_partitioner, n_internal, n_owned);
+    reinit_first_touch(alpha_, scalar_partitioner, n_internal, n_owned);
+    reinit_first_touch(
+        specific_entropies_, scalar_partitioner, n_internal, n_owned);
+    reinit_first_touch(
+        evc_entropies_, scalar_partitioner, n_internal, n_owned);
+#ifdef USE_PRECOMPUTED_FLUXES
+    reinit_first_touch(
+        precomputed_values_,
+        create_vector_partitioner<
+            ProblemDescription<dim, Number>::n_precomputed_values>(
+            scalar_partitioner),
+        n_internal,
+        n_owned);
+#endif
 
-    bounds_.reinit_with_scalar_partitioner(scalar_partitioner);
+    reinit_first_touch(
+        bounds_,
+        create_vector_partitioner<Limiter<dim, Number>::n_bounds>(
+            scalar_partitioner),
+        n_internal,
+        n_owned);
 
     const auto &vector_partitioner = offline_data_->vector_partitioner();
-    r_.reinit(vector_partitioner);
-    temp_euler_.reinit(vector_partitioner);
-    temp_ssp_.reinit(vector_partitioner);
+    reinit_first_touch(r_, vector_partitioner, n_internal, n_owned);
+    reinit_first_touch(temp_euler_, vector_partitioner, n_internal, n_owned);
+    reinit_first_touch(temp_ssp_, vector_partitioner, n_internal, n_owned);
+    /* Only the five and ten stage schemes need a second register: */
+    if constexpr (time_step_order_ == TimeStepOrder::third_order_five_stages ||
+                  time_step_order_ == TimeStepOrder::fourth_order_ten_stages)
+      reinit_first_touch(temp_ssp_2_, vector_partitioner, n_internal, n_owned);
 
     /* Initialize matrices: */
 
@@ -91,7 +171,211 @@ namespace ryujin
     dij_matrix_.reinit(sparsity_simd);
     lij_matrix_.reinit(sparsity_simd);
     lij_matrix_next_.reinit(sparsity_simd);
+#ifndef RECOMPUTE_PIJ
     pij_matrix_.reinit(sparsity_simd);
+#endif
+
+    /*
+     * Set up persistent halo exchanges. Communication channels 0 to 2 are
+     * used here, the l_ij matrices use channels 3 and 4 (see
+     * euler_step()):
+     */
+
+    alpha_exchange_.reinit(*scalar_partitioner, {1, 1}, 0);
+    r_exchange_.reinit(*scalar_partitioner, {problem_dimension}, 1);
+    temp_euler_exchange_.reinit(*scalar_partitioner, {problem_dimension}, 2);
+
+    /*
+     * Export chunks for early halo sends: The import indices of the
+     * scalar partitioner are grouped by import target. The l_ij matrices
+     * send the same rows in the same order (see SparsityPatternSIMD):
+     */
+    {
+      std::vector<unsigned int> import_indices;
+      for (const auto &[begin, end] : scalar_partitioner->import_indices())
+        for (unsigned int i = begin; i < end; ++i)
+          import_indices.push_back(i);
+
+      const auto export_item = [&](const unsigned int i) -> unsigned int {
+        return i < n_internal ? i / simd_length_
+                              : n_internal / simd_length_ + (i - n_internal);
+      };
+
+      std::vector<std::vector<unsigned int>> chunk_items;
+      auto it = import_indices.begin();
+      for (const auto &[rank, n] : scalar_partitioner->import_targets()) {
+        (void)rank;
+        auto &items = chunk_items.emplace_back();
+        for (unsigned int k = 0; k < n; ++k, ++it) {
+          Assert(*it < n_owned, dealii::ExcInternalError());
+          Assert(*it >= n_internal || *it < offline_data_->n_export_indices(),
+                 dealii::ExcInternalError());
+          items.push_back(export_item(*it));
+        }
+      }
+      Assert(it == import_indices.end(), dealii::ExcInternalError());
+
+      export_chunks_.reinit(export_item(n_owned), chunk_items);
+    }
+
+    mpi_thread_multiple_ = false;
+#ifdef DEAL_II_WITH_MPI
+    int provided;
+    const int ierr = MPI_Query_thread(&provided);
+    AssertThrowMPI(ierr);
+    mpi_thread_multiple_ = (provided == MPI_THREAD_MULTIPLE);
+#endif
+
+    for (auto &it : load_balance_statistics_)
+      it.reinit();
+
+    /*
+     * Row blocks for the dataflow execution of Step 0 to Step 2: We split
+     * the vectorized range, the remaining locally owned range, and the
+     * ghost range into (at most) scheduling_chunks_per_thread_ blocks per
+     * thread each. Blocks consist of consecutive rows of about equal
+     * count, such that the static distribution of blocks over threads
+     * matches the one of the row loops (see reinit_first_touch()).
+     *
+     * With USE_DYNAMIC_SCHEDULING blocks are handed out dynamically and
+     * we use a static cost model instead: The cost of a unit (a SIMD row
+     * group or a single row) is taken to be proportional to its row
+     * length. Blocks of the locally owned ranges are cut such that they
+     * all have about the same cost, and such that there are about
+     * scheduling_chunks_per_thread_ blocks per thread for the vectorized
+     * and the remaining locally owned range combined. Ghost rows are only
+     * processed in Step 0 with constant cost per row.
+     */
+    {
+      const unsigned int n_relevant = offline_data_->n_locally_relevant();
+      const unsigned int n_blocks_per_range =
+          std::max(1u, scheduling_chunks_per_thread_) * omp_get_max_threads();
+
+#ifdef USE_DYNAMIC_SCHEDULING
+      double cost_owned = 0.;
+      for (unsigned int i = 0; i < n_internal; i += simd_length_)
+        cost_owned += sparsity_simd.row_length(i);
+      for (unsigned int i = n_internal; i < n_owned; ++i)
+        cost_owned += sparsity_simd.row_length(i);
+      const double cost_per_block = cost_owned / n_blocks_per_range;
+#endif
+
+      block_starts_.clear();
+      const auto add_blocks = [&](const unsigned int begin,
+                                  const unsigned int end,
+                                  const unsigned int granularity,
+                                  const bool cost_weighted) {
+#ifdef USE_DYNAMIC_SCHEDULING
+        if (cost_weighted) {
+          double cost = 0.;
+          for (unsigned int i = begin; i + granularity <= end;
+               i += granularity) {
+            if (i == begin || cost >= cost_per_block) {
+              block_starts_.push_back(i);
+              cost = 0.;
+            }
+            cost += sparsity_simd.row_length(i);
+          }
+          return;
+        }
+#else
+        (void)cost_weighted;
+#endif
+        const std::size_t n_units = (end - begin) / granularity;
+        const std::size_t n_blocks =
+            std::min<std::size_t>(n_blocks_per_range, n_units);
+        for (std::size_t b = 0; b < n_blocks; ++b)
+          block_starts_.push_back(begin + n_units * b / n_blocks * granularity);
+      };
+
+      add_blocks(0, n_internal, simd_length_, true);
+      n_blocks_simd_ = block_starts_.size();
+      add_blocks(n_internal, n_owned, 1, true);
+      n_blocks_owned_ = block_starts_.size();
+      add_blocks(n_owned, n_relevant, 1, false);
+      block_starts_.push_back(n_relevant);
+
+      const auto block_of = [&](const unsigned int row) -> unsigned int {
+        return std::upper_bound(
+                   block_starts_.begin(), block_starts_.end() - 1, row) -
+               block_starts_.begin() - 1;
+      };
+
+      block_dependency_starts_.assign(1, 0);
+      block_dependencies_.clear();
+
+      std::vector<unsigned int> dependencies;
+      for (unsigned int b = 0; b < n_blocks_owned_; ++b) {
+        dependencies.clear();
+        for (unsigned int i = block_starts_[b]; i < block_starts_[b + 1];
+             ++i) {
+          const unsigned int row_length = sparsity_simd.row_length(i);
+          const unsigned int stride = sparsity_simd.stride_of_row(i);
+          const unsigned int *js = sparsity_simd.columns(i);
+          for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx)
+            dependencies.push_back(block_of(js[col_idx * stride]));
+        }
+
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(
+            std::unique(dependencies.begin(), dependencies.end()),
+            dependencies.end());
+
+        block_dependencies_.insert(block_dependencies_.end(),
+                                   dependencies.begin(),
+                                   dependencies.end());
+        block_dependency_starts_.push_back(block_dependencies_.size());
+      }
+
+      block_progress_.reinit(block_starts_.size() - 1);
+
+      /*
+       * Breadth-first search starting from all blocks with a ghost
+       * dependency. The dependency graph is symmetric on the locally
+       * owned range because the sparsity pattern is:
+       */
+
+      constexpr auto unreachable = std::numeric_limits<unsigned int>::max();
+      block_distances_.assign(n_blocks_owned_, unreachable);
+
+      std::vector<unsigned int> queue;
+      for (unsigned int b = 0; b < n_blocks_owned_; ++b)
+        if (block_dependencies_[block_dependency_starts_[b + 1] - 1] >=
+            n_blocks_owned_) {
+          block_distances_[b] = 0;
+          queue.push_back(b);
+        }
+
+      for (std::size_t k = 0; k < queue.size(); ++k) {
+        const unsigned int b = queue[k];
+        for (unsigned int l = block_dependency_starts_[b];
+             l < block_dependency_starts_[b + 1];
+             ++l) {
+          const unsigned int c = block_dependencies_[l];
+          if (c < n_blocks_owned_ && block_distances_[c] == unreachable) {
+            block_distances_[c] = block_distances_[b] + 1;
+            queue.push_back(c);
+          }
+        }
+      }
+    }
+
+#ifdef USE_PRECOMPUTED_NORMALS
+    /* Precompute the relaxation radii used in the limiter: */
+
+    const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
+    const Number measure_of_omega_inverse =
+        Number(1.) / offline_data_->measure_of_omega();
+
+    reinit_first_touch(
+        relaxation_radii_, scalar_partitioner, n_internal, n_owned);
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      const Number m_i = lumped_mass_matrix.local_element(i);
+      relaxation_radii_.local_element(i) =
+          Limiter<dim, Number>::relaxation_radius(m_i *
+                                                  measure_of_omega_inverse);
+    }
+#endif
   }
 
 
@@ -99,6 +383,19 @@ namespace ryujin
   Number
   EulerModule<dim, Number>::euler_step(vector_type &U, Number t, Number tau)
   {
+    return euler_step(U, U, t, tau);
+  }
+
+
+  template <int dim, typename Number>
+  Number EulerModule<dim, Number>::euler_step(const vector_type &U,
+                                              vector_type &U_new,
+                                              Number t,
+                                              Number tau,
+                                              const vector_type *U_old,
+                                              Number a,
+                                              Number b)
+  {
 #ifdef DEBUG_OUTPUT
     std::cout << "EulerModule<dim, Number>::euler_step()" << std::endl;
 #endif
@@ -125,157 +422,379 @@ namespace ryujin
     const auto &mass_matrix = offline_data_->mass_matrix();
     const auto &betaij_matrix = offline_data_->betaij_matrix();
     const auto &cij_matrix = offline_data_->cij_matrix();
+#ifdef USE_PRECOMPUTED_NORMALS
+    const auto &cij_norm_matrix = offline_data_->cij_norm_matrix();
+    const auto &nij_matrix = offline_data_->nij_matrix();
+#endif
+#ifdef USE_EDGE_DIJ
+    const auto &edge_list = offline_data_->edge_list();
+#endif
 
-    const auto &boundary_map = offline_data_->boundary_map();
+    const auto &boundary_table = offline_data_->boundary_table();
+    const auto &boundary_row_groups = offline_data_->boundary_row_groups();
     const Number measure_of_omega_inverse =
         Number(1.) / offline_data_->measure_of_omega();
 
-    /* A monotonically increasing "channel" variable for mpi_tags: */
-    unsigned int channel = 10;
+    /*
+     * Fix up the updated state of a boundary degree of freedom (and do
+     * nothing for all other degrees of freedom):
+     */
+    const auto apply_boundary_conditions = [&](const unsigned int i,
+                                               rank1_type &U_i_new) {
+      if (!boundary_table.is_boundary(i))
+        return;
+
+      const unsigned int slot = boundary_table.slot(i);
+      const auto id = boundary_table.id(slot);
+
+      /* On boundary 1 remove the normal component of the momentum: */
+      if (id == Boundary::slip) {
+        const auto normal = boundary_table.normal(slot);
+        auto m = ProblemDescription<dim, Number>::momentum(U_i_new);
+        m -= 1. * (m * normal) * normal;
+        for (unsigned int k = 0; k < dim; ++k)
+          U_i_new[k + 1] = m[k];
+      }
+
+      /* On boundary 2 enforce initial conditions: */
+      if (id == Boundary::dirichlet) {
+        U_i_new = initial_values_->initial_state(
+            boundary_table.position(slot), t + tau);
+      }
+    };
+
+    /*
+     * The same for a SIMD row group starting at index i. Only groups
+     * consisting of boundary degrees of freedom are touched. The lanes of
+     * such a group occupy consecutive slots of the boundary table, and
+     * the stored normal vanishes for all lanes without slip boundary
+     * conditions. Thus, the slip fix-up is applied to all lanes at once:
+     */
+    const auto apply_boundary_conditions_simd =
+        [&](const unsigned int i,
+            typename ProblemDescription<dim, VA>::rank1_type &U_i_new) {
+          if (!boundary_row_groups[i / simd_length])
+            return;
+
+          const unsigned int slot = boundary_table.slot(i);
+
+          const auto normal =
+              boundary_table.template get_vectorized_normal<VA>(slot);
+          auto m = ProblemDescription<dim, VA>::momentum(U_i_new);
+          m -= (m * normal) * normal;
+          for (unsigned int k = 0; k < dim; ++k)
+            U_i_new[k + 1] = m[k];
+
+          for (unsigned int k = 0; k < simd_length; ++k) {
+            if (boundary_table.id(slot + k) != Boundary::dirichlet)
+              continue;
+            const auto U_k = initial_values_->initial_state(
+                boundary_table.position(slot + k), t + tau);
+            for (unsigned int c = 0; c < problem_dimension; ++c)
+              U_i_new[c][k] = U_k[c];
+          }
+        };
+
+    /*
+     * If the d_ij and l_ij matrices are stored with reduced precision
+     * (USE_MIXED_PRECISION) we round d_ij up and l_ij down prior to
+     * storing them. This ensures that the stored d_ij are still an upper
+     * bound on the maximal wavespeed and that the stored l_ij do not
+     * exceed the computed limiter bounds.
+     */
+    constexpr bool reduced_precision =
+        !std::is_same<Number, dij_storage_type>::value;
+    constexpr Number storage_eps =
+        std::numeric_limits<dij_storage_type>::epsilon();
+
+    const auto round_up = [](const auto &value) {
+      if constexpr (reduced_precision)
+        return value * (Number(1.) + storage_eps);
+      else
+        return value;
+    };
+
+    const auto round_down = [](const auto &value) {
+      if constexpr (reduced_precision)
+        return value * (Number(1.) - storage_eps);
+      else
+        return value;
+    };
+
+    /*
+     * Step 0 to Step 2 are executed as a dataflow computation within a
+     * single parallel region: The locally relevant index range is split
+     * into row blocks (see prepare()). A block is processed in Step 1
+     * (Step 2) as soon as Step 0 (Step 1) has been completed on all
+     * blocks containing a column index of one of its rows. This replaces
+     * two fork/join cycles and thread synchronization barriers by
+     * point-to-point dependencies recorded in block_progress_.
+     *
+     * The first global synchronization point is the computation of
+     * tau_max after Step 2.
+     */
 
     /*
-     * Step 0: Precompute f(U) and the entropies of U
+     * Wait until the given step has been completed on all blocks the
+     * given block depends on:
      */
+    const auto wait_for_dependencies = [&](LoadBalanceStatistics &statistics,
+                                           const unsigned int block,
+                                           const unsigned int step) {
+      statistics.wait([&]() {
+        for (unsigned int k = block_dependency_starts_[block];
+             k < block_dependency_starts_[block + 1];
+             ++k)
+          block_progress_.wait(block_dependencies_[k], step);
+      });
+    };
+
+    std::atomic<Number> tau_max{std::numeric_limits<Number>::infinity()};
+
     {
-      Scope scope(computing_timer_, "time step 0 - compute entropies");
+      Scope scope(computing_timer_,
+                  "time step 0-2 - entropies, d_ij, alpha_i, and tau_max");
+
+      SynchronizationDispatch synchronization_dispatch([&]() {
+        alpha_exchange_.start(alpha_, second_variations_);
+      });
+
+#ifndef USE_EDGE_DIJ
+      /*
+       * In case both dofs are located at the boundary we have to
+       * symmetrize with d_ji computed from c_ji (that differs from -c_ij in
+       * general):
+       */
+      const auto boundary_dji = [&](const unsigned int i,
+                                    const unsigned int j,
+                                    const unsigned int col_idx,
+                                    const Number hd_i) {
+        const auto U_i = U.get_tensor(i);
+        const auto U_j = U.get_tensor(j);
+
+#ifdef USE_PRECOMPUTED_NORMALS
+        const auto norm_2 = cij_norm_matrix.get_transposed_entry(i, col_idx);
+        const auto n_ji = nij_matrix.get_transposed_tensor(i, col_idx);
+#else
+        const auto c_ji = cij_matrix.get_transposed_tensor(i, col_idx);
+        const auto norm_2 = c_ji.norm();
+        const auto n_ji = c_ji / norm_2;
+#endif
+
+#ifdef USE_PRECOMPUTED_FLUXES
+        const auto prec_i = precomputed_values_.get_tensor(i);
+        const auto prec_j = precomputed_values_.get_tensor(j);
+        const auto [lambda_max_2, p_star_2, n_iterations_2] =
+            RiemannSolver<dim, Number>::compute(
+                U_j, U_i, prec_j, prec_i, n_ji, hd_i);
+#else
+        const auto [lambda_max_2, p_star_2, n_iterations_2] =
+            RiemannSolver<dim, Number>::compute(U_j, U_i, n_ji, hd_i);
+#endif
+        return norm_2 * lambda_max_2;
+      };
+#endif
+
+      const unsigned int n_blocks = block_starts_.size() - 1;
+      block_progress_.reset();
 
       RYUJIN_PARALLEL_REGION_BEGIN
+
+      /*
+       * Step 0: Precompute f(U) and the entropies of U
+       *
+       * If USE_PRECOMPUTED_FLUXES is set we also store f(U), 1/rho, the
+       * pressure, and the speed of sound for every locally relevant node.
+       * This way the flux is evaluated once per node instead of twice per
+       * edge (Step 1 and Step 3).
+       */
+
       LIKWID_MARKER_START("time_step_0");
 
-      const unsigned int size_regular = n_relevant / simd_length * simd_length;
+      auto &statistics_0 = load_balance_statistics_[0];
+      statistics_0.begin();
 
-      RYUJIN_OMP_FOR
-      for (unsigned int i = 0; i < size_regular; i += simd_length) {
-        using PD = ProblemDescription<dim, VA>;
+      RYUJIN_OMP_FOR_NOWAIT
+      for (unsigned int block = 0; block < n_blocks; ++block) {
+        const unsigned int begin = block_starts_[block];
+        const unsigned int end = block_starts_[block + 1];
+        const unsigned int end_regular =
+            begin + (end - begin) / simd_length * simd_length;
 
-        const auto U_i = U.get_vectorized_tensor(i);
-        simd_store(specific_entropies_, PD::specific_entropy(U_i), i);
+        for (unsigned int i = begin; i < end_regular; i += simd_length) {
+          using PD = ProblemDescription<dim, VA>;
 
-        const auto evc_entropy =
-            Indicator<dim, double>::evc_entropy_ ==
-                    Indicator<dim, double>::Entropy::mathematical
-                ? PD::mathematical_entropy(U_i)
-                : PD::harten_entropy(U_i);
-        simd_store(evc_entropies_, evc_entropy, i);
-      }
+          const auto U_i = U.get_vectorized_tensor(i);
+          simd_store(specific_entropies_, PD::specific_entropy(U_i), i);
 
-      for (unsigned int i = size_regular; i < n_relevant; ++i) {
-        const auto U_i = U.get_tensor(i);
+          const auto evc_entropy =
+              Indicator<dim, double>::evc_entropy_ ==
+                      Indicator<dim, double>::Entropy::mathematical
+                  ? PD::mathematical_entropy(U_i)
+                  : PD::harten_entropy(U_i);
+          simd_store(evc_entropies_, evc_entropy, i);
 
-        specific_entropies_.local_element(i) =
-            ProblemDescription<dim, Number>::specific_entropy(U_i);
+#ifdef USE_PRECOMPUTED_FLUXES
+          precomputed_values_.write_vectorized_tensor(
+              PD::precompute_values(U_i), i);
+#endif
+        }
 
-        evc_entropies_.local_element(i) =
-            Indicator<dim, double>::evc_entropy_ ==
-                    Indicator<dim, double>::Entropy::mathematical
-                ? ProblemDescription<dim, Number>::mathematical_entropy(U_i)
-                : ProblemDescription<dim, Number>::harten_entropy(U_i);
-      }
+        for (unsigned int i = end_regular; i < end; ++i) {
+          const auto U_i = U.get_tensor(i);
 
-      LIKWID_MARKER_STOP("time_step_0");
-      RYUJIN_PARALLEL_REGION_END
-    }
+          specific_entropies_.local_element(i) =
+              ProblemDescription<dim, Number>::specific_entropy(U_i);
 
-    /*
-     * Step 1: Compute off-diagonal d_ij, and alpha_i
-     *
-     * The computation of the d_ij is quite costly. So we do a trick to
-     * save a bit of computational resources. Instead of computing all d_ij
-     * entries for a row of a given local index i, we only compute d_ij for
-     * which j > i,
-     *
-     *        llllrr
-     *      l .xxxxx
-     *      l ..xxxx
-     *      l ...xxx
-     *      l ....xx
-     *      r ......
-     *      r ......
-     *
-     *  and symmetrize in Step 2.
-     *
-     *  MM: We could save a bit more computational resources by only
-     *  computing entries for which *IN A GLOBAL* enumeration j > i. But
-     *  the index translation, subsequent symmetrization, and exchange
-     *  sounds a bit too expensive...
-     */
+          evc_entropies_.local_element(i) =
+              Indicator<dim, double>::evc_entropy_ ==
+                      Indicator<dim, double>::Entropy::mathematical
+                  ? ProblemDescription<dim, Number>::mathematical_entropy(U_i)
+                  : ProblemDescription<dim, Number>::harten_entropy(U_i);
 
-    {
-      Scope scope(computing_timer_, "time step 1 - compute d_ij, and alpha_i");
+#ifdef USE_PRECOMPUTED_FLUXES
+          precomputed_values_.write_tensor(
+              ProblemDescription<dim, Number>::precompute_values(U_i), i);
+#endif
+        }
 
-      SynchronizationDispatch synchronization_dispatch([&]() {
-        alpha_.update_ghost_values_start(channel++);
-        second_variations_.update_ghost_values_start(channel++);
-      });
+        /*
+         * Ghost blocks are not processed in Step 1. Mark them as completed
+         * for Step 1 as well, such that Step 2 does not wait on them:
+         */
+        block_progress_.mark(block, block < n_blocks_owned_ ? 1 : 2);
+      }
+
+      statistics_0.end();
+
+      LIKWID_MARKER_STOP("time_step_0");
+
+      /*
+       * Step 1: Compute off-diagonal d_ij, and alpha_i
+       *
+       * The computation of the d_ij is quite costly. So we do a trick to
+       * save a bit of computational resources. Instead of computing all d_ij
+       * entries for a row of a given local index i, we only compute d_ij for
+       * which j > i,
+       *
+       *        llllrr
+       *      l .xxxxx
+       *      l ..xxxx
+       *      l ...xxx
+       *      l ....xx
+       *      r ......
+       *      r ......
+       *
+       *  and symmetrize in Step 2.
+       *
+       *  MM: We could save a bit more computational resources by only
+       *  computing entries for which *IN A GLOBAL* enumeration j > i. But
+       *  the index translation, subsequent symmetrization, and exchange
+       *  sounds a bit too expensive...
+       *
+       *  If USE_EDGE_DIJ is set we instead iterate over the precomputed
+       *  OfflineData::edge_list() after the row loops: every unique local
+       *  edge (i, j), i < j, is solved exactly once and d_ij is written to
+       *  both (i, j) and (j, i). This makes the symmetrization in Step 2
+       *  unnecessary.
+       */
 
-      RYUJIN_PARALLEL_REGION_BEGIN
       LIKWID_MARKER_START("time_step_1");
 
+      auto &statistics_1 = load_balance_statistics_[1];
+      statistics_1.begin();
+
       /* Stored thread locally: */
       Indicator<dim, Number> indicator_serial;
 
       /* Parallel non-vectorized loop: */
-      RYUJIN_OMP_FOR_NOWAIT
-      for (unsigned int i = n_internal; i < n_owned; ++i) {
+      RYUJIN_OMP_FOR_DYNAMIC_NOWAIT(1)
+      for (unsigned int block = n_blocks_simd_; block < n_blocks_owned_;
+           ++block) {
 
-        const unsigned int row_length = sparsity_simd.row_length(i);
+        wait_for_dependencies(statistics_1, block, 1);
 
-        /* Skip constrained degrees of freedom */
-        if (row_length == 1)
-          continue;
+        for (unsigned int i = block_starts_[block];
+             i < block_starts_[block + 1];
+             ++i) {
 
-        const auto U_i = U.get_tensor(i);
-        const Number mass = lumped_mass_matrix.local_element(i);
-        const Number hd_i = mass * measure_of_omega_inverse;
+          const unsigned int row_length = sparsity_simd.row_length(i);
 
-        indicator_serial.reset(U_i, evc_entropies_.local_element(i));
+          /* Skip constrained degrees of freedom */
+          if (row_length == 1)
+            continue;
 
-        /* Skip diagonal. */
-        const unsigned int *js = sparsity_simd.columns(i);
-        for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
-          const unsigned int j = js[col_idx];
+          const auto U_i = U.get_tensor(i);
+          const Number mass = lumped_mass_matrix.local_element(i);
+          const Number hd_i = mass * measure_of_omega_inverse;
 
-          const auto U_j = U.get_tensor(j);
+#ifdef USE_PRECOMPUTED_FLUXES
+          const auto prec_i = precomputed_values_.get_tensor(i);
+          indicator_serial.reset(U_i, prec_i, evc_entropies_.local_element(i));
+#else
+          indicator_serial.reset(U_i, evc_entropies_.local_element(i));
+#endif
 
-          const auto c_ij = cij_matrix.get_tensor(i, col_idx);
-          const auto beta_ij = betaij_matrix.get_entry(i, col_idx);
-          indicator_serial.add(
-              U_j, c_ij, beta_ij, evc_entropies_.local_element(j));
+          /* Skip diagonal. */
+          const unsigned int *js = sparsity_simd.columns(i);
+          for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+            const unsigned int j = js[col_idx];
 
-          /* Only iterate over the upper triangular portion of d_ij */
-          if (j <= i)
-            continue;
+            const auto U_j = U.get_tensor(j);
 
-          const auto norm = c_ij.norm();
-          const auto n_ij = c_ij / norm;
+            const auto c_ij = cij_matrix.get_tensor(i, col_idx);
+            const auto beta_ij = betaij_matrix.get_entry(i, col_idx);
+#ifdef USE_PRECOMPUTED_FLUXES
+            const auto prec_j = precomputed_values_.get_tensor(j);
+            indicator_serial.add(
+                U_j, prec_j, c_ij, beta_ij, evc_entropies_.local_element(j));
+#else
+            indicator_serial.add(
+                U_j, c_ij, beta_ij, evc_entropies_.local_element(j));
+#endif
 
-          const auto [lambda_max, p_star, n_iterations] =
-              RiemannSolver<dim, Number>::compute(U_i, U_j, n_ij, hd_i);
+#ifndef USE_EDGE_DIJ
+            /* Only iterate over the upper triangular portion of d_ij */
+            if (j <= i)
+              continue;
 
-          Number d = norm * lambda_max;
+#ifdef USE_PRECOMPUTED_NORMALS
+            const auto norm = cij_norm_matrix.get_entry(i, col_idx);
+            const auto n_ij = nij_matrix.get_tensor(i, col_idx);
+#else
+            const auto norm = c_ij.norm();
+            const auto n_ij = c_ij / norm;
+#endif
 
-          /*
-           * In case both dofs are located at the boundary we have to
-           * symmetrize.
-           */
+#ifdef USE_PRECOMPUTED_FLUXES
+            const auto [lambda_max, p_star, n_iterations] =
+                RiemannSolver<dim, Number>::compute(
+                    U_i, U_j, prec_i, prec_j, n_ij, hd_i);
+#else
+            const auto [lambda_max, p_star, n_iterations] =
+                RiemannSolver<dim, Number>::compute(U_i, U_j, n_ij, hd_i);
+#endif
+
+            Number d = norm * lambda_max;
 
-          if (boundary_map.count(i) != 0 && boundary_map.count(j) != 0) {
+            /*
+             * In case both dofs are located at the boundary we have to
+             * symmetrize.
+             */
 
-            const auto c_ji = cij_matrix.get_transposed_tensor(i, col_idx);
-            const auto norm_2 = c_ji.norm();
-            const auto n_ji = c_ji / norm_2;
+            if (boundary_table.is_boundary(i) && boundary_table.is_boundary(j))
+              d = std::max(d, boundary_dji(i, j, col_idx, hd_i));
 
-            auto [lambda_max_2, p_star_2, n_iterations_2] =
-                RiemannSolver<dim, Number>::compute(U_j, U_i, n_ji, hd_i);
-            d = std::max(d, norm_2 * lambda_max_2);
+            dij_matrix_.write_entry(round_up(d), i, col_idx);
+#endif
           }
 
-          dij_matrix_.write_entry(d, i, col_idx);
+          alpha_.local_element(i) = indicator_serial.alpha(hd_i);
+          second_variations_.local_element(i) =
+              indicator_serial.second_variations();
         }
 
-        alpha_.local_element(i) = indicator_serial.alpha(hd_i);
-        second_variations_.local_element(i) =
-            indicator_serial.second_variations();
+        block_progress_.mark(block, 2);
       } /* parallel non-vectorized loop */
 
       /* Stored thread locally: */
@@ -283,116 +802,322 @@ namespace ryujin
       bool thread_ready = false;
 
       /* Parallel SIMD loop: */
-      RYUJIN_OMP_FOR
-      for (unsigned int i = 0; i < n_internal; i += simd_length) {
+      RYUJIN_OMP_FOR_DYNAMIC_NOWAIT(1)
+      for (unsigned int block = 0; block < n_blocks_simd_; ++block) {
 
-        synchronization_dispatch.check(thread_ready, i >= n_export_indices);
+        wait_for_dependencies(statistics_1, block, 1);
 
-        const auto U_i = U.get_vectorized_tensor(i);
-        const auto entropy_i = simd_load(evc_entropies_, i);
+        for (unsigned int i = block_starts_[block];
+             i < block_starts_[block + 1];
+             i += simd_length) {
 
-        indicator_simd.reset(U_i, entropy_i);
+          synchronization_dispatch.check(thread_ready, i >= n_export_indices);
 
-        const auto mass = simd_load(lumped_mass_matrix, i);
-        const auto hd_i = mass * measure_of_omega_inverse;
+          const auto U_i = U.get_vectorized_tensor(i);
+          const auto entropy_i = simd_load(evc_entropies_, i);
 
-        const unsigned int row_length = sparsity_simd.row_length(i);
+#ifdef USE_PRECOMPUTED_FLUXES
+          const auto prec_i = precomputed_values_.get_vectorized_tensor(i);
+          indicator_simd.reset(U_i, prec_i, entropy_i);
+#else
+          indicator_simd.reset(U_i, entropy_i);
+#endif
 
-        /* Skip diagonal. */
-        const unsigned int *js = sparsity_simd.columns(i) + simd_length;
-        for (unsigned int col_idx = 1; col_idx < row_length;
-             ++col_idx, js += simd_length) {
+          const auto mass = simd_load(lumped_mass_matrix, i);
+          const auto hd_i = mass * measure_of_omega_inverse;
 
-          bool all_below_diagonal = true;
-          for (unsigned int k = 0; k < simd_length; ++k)
-            if (js[k] >= i + k) {
-              all_below_diagonal = false;
-              break;
-            }
+          const unsigned int row_length = sparsity_simd.row_length(i);
 
-          const auto U_j = U.get_vectorized_tensor(js);
-          const auto entropy_j = simd_load(evc_entropies_, js);
+          /* Skip diagonal. */
+          const unsigned int *js = sparsity_simd.columns(i) + simd_length;
+          for (unsigned int col_idx = 1; col_idx < row_length;
+               ++col_idx, js += simd_length) {
 
-          const auto c_ij = cij_matrix.get_vectorized_tensor(i, col_idx);
-          const auto beta_ij = betaij_matrix.get_vectorized_entry(i, col_idx);
-          indicator_simd.add(U_j, c_ij, beta_ij, entropy_j);
+            const auto U_j = U.get_vectorized_tensor(js);
+            const auto entropy_j = simd_load(evc_entropies_, js);
 
-          /* Only iterate over the upper triangular portion of d_ij */
-          if (all_below_diagonal)
-            continue;
+            const auto c_ij = cij_matrix.get_vectorized_tensor(i, col_idx);
+            const auto beta_ij = betaij_matrix.get_vectorized_entry(i, col_idx);
+#ifdef USE_PRECOMPUTED_FLUXES
+            const auto prec_j = precomputed_values_.get_vectorized_tensor(js);
+            indicator_simd.add(U_j, prec_j, c_ij, beta_ij, entropy_j);
+#else
+            indicator_simd.add(U_j, c_ij, beta_ij, entropy_j);
+#endif
+
+#ifndef USE_EDGE_DIJ
+            bool all_below_diagonal = true;
+            for (unsigned int k = 0; k < simd_length; ++k)
+              if (js[k] >= i + k) {
+                all_below_diagonal = false;
+                break;
+              }
+
+            /* Only iterate over the upper triangular portion of d_ij */
+            if (all_below_diagonal)
+              continue;
+
+#ifdef USE_PRECOMPUTED_NORMALS
+            const auto norm = cij_norm_matrix.get_vectorized_entry(i, col_idx);
+            const auto n_ij = nij_matrix.get_vectorized_tensor(i, col_idx);
+#else
+            const auto norm = c_ij.norm();
+            const auto n_ij = c_ij / norm;
+#endif
+
+#ifdef USE_PRECOMPUTED_FLUXES
+            const auto [lambda_max, p_star, n_iterations] =
+                RiemannSolver<dim, VA>::compute(
+                    U_i, U_j, prec_i, prec_j, n_ij, hd_i);
+#else
+            const auto [lambda_max, p_star, n_iterations] =
+                RiemannSolver<dim, VA>::compute(U_i, U_j, n_ij, hd_i);
+#endif
+
+            auto d = norm * lambda_max;
 
-          const auto norm = c_ij.norm();
-          const auto n_ij = c_ij / norm;
+            /*
+             * In case both dofs are located at the boundary we have to
+             * symmetrize.
+             */
 
-          const auto [lambda_max, p_star, n_iterations] =
-              RiemannSolver<dim, VA>::compute(U_i, U_j, n_ij, hd_i);
+            if (boundary_row_groups[i / simd_length])
+              for (unsigned int k = 0; k < simd_length; ++k)
+                if (js[k] > i + k && boundary_table.is_boundary(js[k])) {
+                  const auto d_ji =
+                      boundary_dji(i + k, js[k], col_idx, hd_i[k]);
+                  d[k] = std::max(d[k], d_ji);
+                }
 
-          const auto d = norm * lambda_max;
+            dij_matrix_.write_vectorized_entry(round_up(d), i, col_idx, true);
+#endif
+          }
 
-          dij_matrix_.write_vectorized_entry(d, i, col_idx, true);
+          simd_store(alpha_, indicator_simd.alpha(hd_i), i);
+          simd_store(second_variations_, indicator_simd.second_variations(), i);
         }
 
-        simd_store(alpha_, indicator_simd.alpha(hd_i), i);
-        simd_store(second_variations_, indicator_simd.second_variations(), i);
+        block_progress_.mark(block, 2);
       } /* parallel SIMD loop */
 
-      LIKWID_MARKER_STOP("time_step_1");
-      RYUJIN_PARALLEL_REGION_END
-    }
+#ifdef USE_EDGE_DIJ
+      /*
+       * The edge loops write d_ij into rows of arbitrary blocks. Thus, we
+       * have to synchronize globally:
+       */
 
-    /*
-     * Step 2: Compute diagonal of d_ij, and maximal time-step size.
-     */
+      statistics_1.barrier();
 
-    std::atomic<Number> tau_max{std::numeric_limits<Number>::infinity()};
+      const unsigned int n_edges = edge_list.n_edges();
+      const unsigned int n_edges_regular =
+          n_edges / simd_length * simd_length;
 
-    {
-      Scope scope(computing_timer_, "time step 2 - compute d_ii, and tau_max");
+      /* Parallel SIMD loop over edges: */
+      RYUJIN_OMP_FOR_NOWAIT
+      for (unsigned int e = 0; e < n_edges_regular; e += simd_length) {
+
+        const unsigned int *is = edge_list.rows(e);
+        const unsigned int *js = edge_list.columns(e);
+
+        const auto U_i = U.get_vectorized_tensor(is);
+        const auto U_j = U.get_vectorized_tensor(js);
+
+        const auto mass = simd_load(lumped_mass_matrix, is);
+        const auto hd_i = mass * measure_of_omega_inverse;
+
+#ifdef USE_PRECOMPUTED_NORMALS
+        const auto norm = edge_list.get_vectorized_norm(e);
+        const auto n_ij = edge_list.get_vectorized_normal(e);
+#else
+        dealii::Tensor<1, dim, VA> c_ij;
+        for (unsigned int k = 0; k < simd_length; ++k) {
+          const auto c = cij_matrix.get_tensor(
+              is[k], edge_list.position_in_row(e + k));
+          for (unsigned int d = 0; d < dim; ++d)
+            c_ij[d][k] = c[d];
+        }
+        const auto norm = c_ij.norm();
+        const auto n_ij = c_ij / norm;
+#endif
+
+#ifdef USE_PRECOMPUTED_FLUXES
+        const auto prec_i = precomputed_values_.get_vectorized_tensor(is);
+        const auto prec_j = precomputed_values_.get_vectorized_tensor(js);
+        const auto [lambda_max, p_star, n_iterations] =
+            RiemannSolver<dim, VA>::compute(
+                U_i, U_j, prec_i, prec_j, n_ij, hd_i);
+#else
+        const auto [lambda_max, p_star, n_iterations] =
+            RiemannSolver<dim, VA>::compute(U_i, U_j, n_ij, hd_i);
+#endif
+
+        const auto d = round_up(norm * lambda_max);
+
+        for (unsigned int k = 0; k < simd_length; ++k) {
+          const unsigned int col_idx = edge_list.position_in_row(e + k);
+          dij_matrix_.write_entry(d[k], is[k], col_idx);
+          const unsigned int col_jdx = edge_list.position_in_column(e + k);
+          if (col_jdx != numbers::invalid_unsigned_int)
+            dij_matrix_.write_entry(d[k], js[k], col_jdx);
+        }
+      } /* parallel SIMD loop over edges */
+
+      /* Parallel non-vectorized loop over remaining edges: */
+      RYUJIN_OMP_FOR_NOWAIT
+      for (unsigned int e = n_edges_regular; e < n_edges; ++e) {
+
+        const unsigned int i = *edge_list.rows(e);
+        const unsigned int j = *edge_list.columns(e);
+
+        const auto U_i = U.get_tensor(i);
+        const auto U_j = U.get_tensor(j);
+
+        const Number mass = lumped_mass_matrix.local_element(i);
+        const Number hd_i = mass * measure_of_omega_inverse;
+
+#ifdef USE_PRECOMPUTED_NORMALS
+        const Number norm = edge_list.get_norm(e);
+        const auto n_ij = edge_list.get_normal(e);
+#else
+        const auto c_ij =
+            cij_matrix.get_tensor(i, edge_list.position_in_row(e));
+        const Number norm = c_ij.norm();
+        const auto n_ij = c_ij / norm;
+#endif
+
+#ifdef USE_PRECOMPUTED_FLUXES
+        const auto prec_i = precomputed_values_.get_tensor(i);
+        const auto prec_j = precomputed_values_.get_tensor(j);
+        const auto [lambda_max, p_star, n_iterations] =
+            RiemannSolver<dim, Number>::compute(
+                U_i, U_j, prec_i, prec_j, n_ij, hd_i);
+#else
+        const auto [lambda_max, p_star, n_iterations] =
+            RiemannSolver<dim, Number>::compute(U_i, U_j, n_ij, hd_i);
+#endif
+
+        const Number d = round_up(norm * lambda_max);
+
+        dij_matrix_.write_entry(d, i, edge_list.position_in_row(e));
+        const unsigned int col_jdx = edge_list.position_in_column(e);
+        if (col_jdx != numbers::invalid_unsigned_int)
+          dij_matrix_.write_entry(d, j, col_jdx);
+      } /* parallel non-vectorized loop over remaining edges */
+
+      statistics_1.barrier();
+
+      /*
+       * In case both dofs are located at the boundary we have to
+       * symmetrize:
+       */
+
+      RYUJIN_OMP_FOR_NOWAIT
+      for (unsigned int k = 0; k < edge_list.n_boundary_edges(); ++k) {
+
+        const unsigned int e = edge_list.boundary_edge(k);
+        const unsigned int i = *edge_list.rows(e);
+        const unsigned int j = *edge_list.columns(e);
+        const unsigned int col_idx = edge_list.position_in_row(e);
+
+        const auto U_i = U.get_tensor(i);
+        const auto U_j = U.get_tensor(j);
+
+        const Number mass = lumped_mass_matrix.local_element(i);
+        const Number hd_i = mass * measure_of_omega_inverse;
+
+        const auto &c_ji = edge_list.get_boundary_cji(k);
+        const auto norm_2 = c_ji.norm();
+        const auto n_ji = c_ji / norm_2;
+
+#ifdef USE_PRECOMPUTED_FLUXES
+        const auto prec_i = precomputed_values_.get_tensor(i);
+        const auto prec_j = precomputed_values_.get_tensor(j);
+        const auto [lambda_max_2, p_star_2, n_iterations_2] =
+            RiemannSolver<dim, Number>::compute(
+                U_j, U_i, prec_j, prec_i, n_ji, hd_i);
+#else
+        const auto [lambda_max_2, p_star_2, n_iterations_2] =
+            RiemannSolver<dim, Number>::compute(U_j, U_i, n_ji, hd_i);
+#endif
+
+        const Number d = std::max(dij_matrix_.get_entry(i, col_idx),
+                                  round_up(norm_2 * lambda_max_2));
+
+        dij_matrix_.write_entry(d, i, col_idx);
+        const unsigned int col_jdx = edge_list.position_in_column(e);
+        if (col_jdx != numbers::invalid_unsigned_int)
+          dij_matrix_.write_entry(d, j, col_jdx);
+      }
+
+      statistics_1.barrier();
+#endif
+
+      statistics_1.end();
+
+      LIKWID_MARKER_STOP("time_step_1");
+
+      /*
+       * Step 2: Compute diagonal of d_ij, and maximal time-step size.
+       */
 
-      /* Parallel region */
-      RYUJIN_PARALLEL_REGION_BEGIN
       LIKWID_MARKER_START("time_step_2");
 
+      auto &statistics_2 = load_balance_statistics_[2];
+      statistics_2.begin();
+
       /* Parallel non-vectorized loop: */
-      RYUJIN_OMP_FOR
-      for (unsigned int i = 0; i < n_owned; ++i) {
+      RYUJIN_OMP_FOR_DYNAMIC_NOWAIT(1)
+      for (unsigned int block = 0; block < n_blocks_owned_; ++block) {
 
-        const unsigned int row_length = sparsity_simd.row_length(i);
+        wait_for_dependencies(statistics_2, block, 2);
 
-        /* Skip constrained degrees of freedom */
-        if (row_length == 1)
-          continue;
+        for (unsigned int i = block_starts_[block];
+             i < block_starts_[block + 1];
+             ++i) {
 
-        Number d_sum = Number(0.);
+          const unsigned int row_length = sparsity_simd.row_length(i);
 
-        const unsigned int *js = sparsity_simd.columns(i);
+          /* Skip constrained degrees of freedom */
+          if (row_length == 1)
+            continue;
 
-        /* skip diagonal: */
-        for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
-          const auto j =
-              *(i < n_internal ? js + col_idx * simd_length : js + col_idx);
+          Number d_sum = Number(0.);
 
-          // fill lower triangular part of dij_matrix missing from step 1
-          if (j < i) {
-            const auto d_ji = dij_matrix_.get_transposed_entry(i, col_idx);
-            dij_matrix_.write_entry(d_ji, i, col_idx);
-          }
+#ifndef USE_EDGE_DIJ
+          const unsigned int *js = sparsity_simd.columns(i);
+#endif
 
-          d_sum -= dij_matrix_.get_entry(i, col_idx);
-        }
+          /* skip diagonal: */
+          for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+#ifndef USE_EDGE_DIJ
+            const auto j =
+                *(i < n_internal ? js + col_idx * simd_length : js + col_idx);
 
-        /* write diagonal element */
-        dij_matrix_.write_entry(d_sum, i, 0);
+            // fill lower triangular part of dij_matrix missing from step 1
+            if (j < i) {
+              const auto d_ji = dij_matrix_.get_transposed_entry(i, col_idx);
+              dij_matrix_.write_entry(d_ji, i, col_idx);
+            }
+#endif
 
-        const Number mass = lumped_mass_matrix.local_element(i);
-        const Number tau = cfl_update_ * mass / (Number(-2.) * d_sum);
+            d_sum -= dij_matrix_.get_entry(i, col_idx);
+          }
 
-        Number current_tau_max = tau_max.load();
-        while (current_tau_max > tau &&
-               !tau_max.compare_exchange_weak(current_tau_max, tau))
-          ;
+          /* write diagonal element */
+          dij_matrix_.write_entry(d_sum, i, 0);
+
+          const Number mass = lumped_mass_matrix.local_element(i);
+          const Number tau = cfl_update_ * mass / (Number(-2.) * d_sum);
+
+          Number current_tau_max = tau_max.load();
+          while (current_tau_max > tau &&
+                 !tau_max.compare_exchange_weak(current_tau_max, tau))
+            ;
+        }
       } /* parallel non-vectorized loop */
 
+      statistics_2.barrier();
+
       LIKWID_MARKER_STOP("time_step_2");
       RYUJIN_PARALLEL_REGION_END
     }
@@ -400,37 +1125,111 @@ namespace ryujin
     {
       Scope scope(computing_timer_, "time step 2 - synchronization barrier");
 
-      alpha_.update_ghost_values_finish();
-      second_variations_.update_ghost_values_finish();
+      alpha_exchange_.finish();
+    }
+
+    constexpr unsigned int n_passes =
+        (order_ == Order::second_order ? limiter_iter_ : 0);
+
+    /*
+     * Reduce tau_max over all MPI ranks with a non-blocking collective:
+     * Step 3 only depends on tau in the final low-order update. We thus
+     * accumulate the low-order increment in Step 3 and apply it in Step 4
+     * while the reduction is in flight. For first-order updates
+     * (n_passes == 0) there is no subsequent step and we complete the
+     * reduction right away.
+     *
+     * The time between start and completion of the reduction is recorded
+     * in the "tau_max reduction (hidden)" timer, the time spent blocking
+     * in MPI_Wait for its completion in the "tau_max reduction (exposed)"
+     * timer.
+     */
+
+    Number tau_max_global = tau_max.load();
+    bool tau_valid = true;
+    bool tau_accepted = true;
+
+#ifdef DEAL_II_WITH_MPI
+    MPI_Request tau_max_request;
+    {
+      const int ierr = MPI_Iallreduce(
+          MPI_IN_PLACE,
+          &tau_max_global,
+          1,
+          std::is_same<Number, double>::value ? MPI_DOUBLE : MPI_FLOAT,
+          MPI_MIN,
+          mpi_communicator_,
+          &tau_max_request);
+      AssertThrowMPI(ierr);
+    }
+#endif
+
+    auto &tau_max_hidden_timer =
+        computing_timer_["time step 2 - tau_max reduction (hidden)"];
+    auto &tau_max_exposed_timer =
+        computing_timer_["time step 2 - tau_max reduction (exposed)"];
+    tau_max_hidden_timer.start();
 
-      /* MPI Barrier: */
-      tau_max.store(Utilities::MPI::min(tau_max.load(), mpi_communicator_));
+    /*
+     * Determine tau after the reduction of tau_max has completed. Errors
+     * are recorded in tau_valid and tau_accepted and handled outside of
+     * parallel regions:
+     */
+    const auto finalize_tau = [&]() {
+      tau_max_hidden_timer.stop();
+      tau_max.store(tau_max_global);
+      tau_valid = !std::isnan(tau_max_global) &&
+                  !std::isinf(tau_max_global) && tau_max_global > 0.;
+      tau = (tau == Number(0.) ? tau_factor_ * tau_max_global : tau);
+      tau_accepted =
+          tau_valid && !(tau * cfl_update_ > tau_max_global * cfl_max_);
+    };
 
-      AssertThrow(!std::isnan(tau_max) && !std::isinf(tau_max) && tau_max > 0.,
+    /*
+     * Complete the reduction of tau_max and determine tau. Must be called
+     * by a single thread while no other thread issues MPI calls:
+     */
+    const auto complete_tau_reduction = [&]() {
+      tau_max_exposed_timer.start();
+#ifdef DEAL_II_WITH_MPI
+      const int ierr = MPI_Wait(&tau_max_request, MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+#endif
+      tau_max_exposed_timer.stop();
+      finalize_tau();
+    };
+
+    /*
+     * Check the outcome of the reduction: Throw on a crashed state, and
+     * refuse the update for insufficient CFL:
+     */
+    const auto check_tau = [&]() {
+      AssertThrow(tau_valid,
                   ExcMessage("I'm sorry, Dave. I'm afraid I can't "
                              "do that. - We crashed."));
 
 #ifdef DEBUG_OUTPUT
       std::cout << "        computed tau_max = " << tau_max << std::endl;
-#endif
-      tau = (tau == Number(0.) ? tau_max.load() : tau);
-#ifdef DEBUG_OUTPUT
       std::cout << "        perform time-step with tau = " << tau << std::endl;
 #endif
 
-      if (tau * cfl_update_ > tau_max.load() * cfl_max_) {
+      if (!tau_accepted) {
 #ifdef DEBUG_OUTPUT
         std::cout
             << "        insufficient CFL, refuse update and abort stepping"
             << std::endl;
 #endif
-        U[0] *= std::numeric_limits<Number>::quiet_NaN();
-        return tau_max;
+        U_new[0] *= std::numeric_limits<Number>::quiet_NaN();
       }
-    }
 
-    constexpr unsigned int n_passes =
-        (order_ == Order::second_order ? limiter_iter_ : 0);
+      return tau_accepted;
+    };
+
+    if constexpr (n_passes == 0) {
+      complete_tau_reduction();
+      if (!check_tau())
+        return tau_max;
+    }
 
     /*
      * Step 3: Low-order update, also compute limiter bounds, R_i
@@ -440,397 +1239,590 @@ namespace ryujin
      *        R_i = \sum_j - c_ij f_j + d_ij^H (U_j - U_i)
      *
      *   Low-order update: += tau / m_i * 2 d_ij^L (\bar U_ij)
+     *
+     * Step 4: Compute P_ij, and l_ij (first round):
+     *
+     *    P_ij = tau / m_i / lambda ( (d_ij^H - d_ij^L) (U_i - U_j) +
+     *                                (b_ij R_j - b_ji R_i) )
+     *
+     * Step 5, 6, ..., 4 + n_passes: Perform high-order update:
+     *
+     *   Symmetrize l_ij
+     *   High-order update: += l_ij * lambda * P_ij
+     *   Compute next l_ij
+     *
+     * If RECOMPUTE_PIJ is set, P_ij is not read from pij_matrix_ but
+     * recomputed from U, r_, alpha_, and d_ij (exactly as in Step 4) and
+     * cached in a thread-local row buffer for the computation of the next
+     * l_ij.
      */
 
-    {
-      Scope scope(computing_timer_,
-                  "time step 3 - l.-o. update, bounds, and r_i");
-
-      SynchronizationDispatch synchronization_dispatch([&]() {
-        if (n_passes != 0) {
-          r_.update_ghost_values_start(channel++);
-        } else {
-          /* If we do not do high-order, synchronize at this point: */
-          temp_euler_.update_ghost_values_start(channel++);
-        }
-      });
-
-      /* Parallel region */
-      RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START("time_step_3");
+#ifdef RECOMPUTE_PIJ
+    static_assert(n_passes <= 2,
+                  "RECOMPUTE_PIJ is only implemented for at most two limiter "
+                  "passes");
+#endif
 
-      /* Nota bene: This bounds variable is thread local: */
-      Limiter<dim, Number> limiter_serial;
+    /*
+     * Step 3 to Step 4 + n_passes ("stages" 0 to n_stages - 1) are
+     * executed within a single parallel region. Stage s of a row reads
+     * results of stage s - 1 of all its neighbors, and every stage ends
+     * with a halo exchange of its results.
+     *
+     * If temporal_blocking_ is set, every block with a distance of at
+     * least s to the MPI halo (see prepare()) is processed in stage s in
+     * a staggered wavefront first ("phase A"): A block enters stage s as
+     * soon as stage s - 1 has been completed on all blocks it depends on.
+     * This way r_, bounds_, p_ij, and l_ij of a block are consumed by the
+     * next stage while they still reside in cache. The remaining blocks
+     * around the halo are then processed stage by stage, each stage
+     * separated by a thread synchronization barrier and the completion of
+     * the preceding halo exchange ("phase B").
+     *
+     * Otherwise, phase A consists of Step 3 only and every subsequent
+     * stage is processed on all blocks in phase B.
+     */
 
-      /* Parallel non-vectorized loop: */
-      RYUJIN_OMP_FOR_NOWAIT
-      for (unsigned int i = n_internal; i < n_owned; ++i) {
+    constexpr unsigned int n_stages = (n_passes == 0 ? 1 : 2 + n_passes);
 
-        /* Skip constrained degrees of freedom */
-        const unsigned int row_length = sparsity_simd.row_length(i);
-        if (row_length == 1)
-          continue;
+    {
+      /*
+       * The l_ij of limiter pass p are stored in lij[p % 2], the l_ij
+       * computed in pass p for the next pass in lij[(p + 1) % 2]:
+       */
+      const std::array<decltype(&lij_matrix_), 2> lij{
+          {&lij_matrix_, &lij_matrix_next_}};
+
+      /*
+       * Stage 0 exchanges r_, stage s > 0 the l_ij computed in that
+       * stage, and the last stage the new state. Every exchange reuses
+       * its persistent MPI requests; the l_ij matrices use the fixed
+       * communication channels 3 and 4:
+       */
+      const auto start_exchange = [&](const unsigned int stage) {
+        if (stage + 1 == n_stages)
+          temp_euler_exchange_.start(temp_euler_);
+        else if (stage == 0)
+          r_exchange_.start(r_);
+        else
+          lij[(stage - 1) % 2]->update_ghost_rows_start(3 + (stage - 1) % 2);
+      };
+
+      const auto finish_exchange = [&](const unsigned int stage) {
+        if (stage + 1 == n_stages)
+          temp_euler_exchange_.finish();
+        else if (stage == 0)
+          r_exchange_.finish();
+        else
+          lij[(stage - 1) % 2]->update_ghost_rows_finish();
+      };
+
+      /*
+       * Early halo sends: Instead of starting the whole exchange of a
+       * stage once all threads have left the export range, the receives
+       * of a stage are started up front and the message for every
+       * neighboring MPI rank is sent by the thread that completes the
+       * last of its rows (see ChunkedSynchronizationDispatch). Unless MPI
+       * supports MPI_THREAD_MULTIPLE, all MPI calls of the sending
+       * threads are serialized with a mutex. Outside of the sends all MPI
+       * calls are issued by a single thread after a thread
+       * synchronization barrier.
+       */
+      const bool early_sends =
+          early_halo_sends_ && HaloExchange<Number>::supports_individual_sends;
+
+      const auto start_receives = [&](const unsigned int stage) {
+        if (stage + 1 == n_stages)
+          temp_euler_exchange_.start_receives(temp_euler_);
+        else if (stage == 0)
+          r_exchange_.start_receives(r_);
+        else
+          lij[(stage - 1) % 2]->update_ghost_rows_start_receives(
+              3 + (stage - 1) % 2);
+      };
+
+      std::mutex mpi_mutex;
+      const auto send = [&](const unsigned int stage,
+                            const unsigned int target) {
+        std::unique_lock<std::mutex> lock(mpi_mutex, std::defer_lock);
+        if (!mpi_thread_multiple_)
+          lock.lock();
+
+        if (stage + 1 == n_stages)
+          temp_euler_exchange_.send(target);
+        else if (stage == 0)
+          r_exchange_.send(target);
+        else
+          lij[(stage - 1) % 2]->update_ghost_rows_send(target);
+      };
+
+      const auto start_exchange_serialized = [&](const unsigned int stage) {
+        std::unique_lock<std::mutex> lock(mpi_mutex, std::defer_lock);
+        if (!mpi_thread_multiple_)
+          lock.lock();
+
+        start_exchange(stage);
+      };
+
+      /*
+       * Stage 1 and all subsequent stages depend on tau. Instead of
+       * synchronizing all threads after Step 3, every block of these
+       * stages waits for the completion of the tau_max reduction
+       * individually (see wait_for_tau()). The reduction is progressed
+       * with MPI_Test after every block of Step 3 and while waiting. The
+       * request is only ever tested by the thread holding mpi_mutex,
+       * which also serializes these calls with the halo exchange of Step
+       * 3 unless MPI supports MPI_THREAD_MULTIPLE.
+       */
+      std::atomic<bool> tau_complete{n_passes == 0};
+
+      /* Test for completion of the reduction, return true if complete: */
+      const auto progress_tau_reduction = [&]() {
+        if (tau_complete.load(std::memory_order_acquire))
+          return true;
+
+        std::unique_lock<std::mutex> lock(mpi_mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+          return false;
+
+        if (tau_complete.load(std::memory_order_relaxed))
+          return true;
+
+        int flag = 1;
+#ifdef DEAL_II_WITH_MPI
+        const int ierr = MPI_Test(&tau_max_request, &flag, MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+#endif
+        if (flag == 0)
+          return false;
+
+        finalize_tau();
+        tau_complete.store(true, std::memory_order_release);
+        return true;
+      };
+
+      const auto wait_for_tau = [&](LoadBalanceStatistics &statistics) {
+        if (tau_complete.load(std::memory_order_acquire))
+          return;
+        statistics.wait([&]() {
+          while (!progress_tau_reduction()) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+          }
+        });
+      };
+
+      /*
+       * Only one kind of dispatch is created: Both execute all pending
+       * payloads on destruction.
+       */
+      std::deque<SynchronizationDispatch<std::function<void()>>>
+          synchronization_dispatches;
+      std::deque<ChunkedSynchronizationDispatch<
+          std::function<void(unsigned int)>>>
+          chunked_dispatches;
+      for (unsigned int stage = 0; stage < n_stages; ++stage) {
+        if (early_sends)
+          chunked_dispatches.emplace_back(
+              export_chunks_, [&send, stage](const unsigned int target) {
+                send(stage, target);
+              });
+        else
+          synchronization_dispatches.emplace_back(
+              [&start_exchange_serialized, stage]() {
+                start_exchange_serialized(stage);
+              });
+      }
 
-        const auto U_i = U.get_tensor(i);
-        const auto f_i = ProblemDescription<dim, Number>::f(U_i);
-        auto U_i_new = U_i;
-        const auto alpha_i = alpha_.local_element(i);
-        const auto variations_i = second_variations_.local_element(i);
+      const auto flush_dispatch = [&](const unsigned int stage) {
+        if (early_sends)
+          chunked_dispatches[stage].flush();
+        else
+          synchronization_dispatches[stage].flush();
+      };
+
+      const auto statistics_of =
+          [&](const unsigned int stage) -> LoadBalanceStatistics & {
+        return load_balance_statistics_[std::min(3u + stage, 5u)];
+      };
+
+      /* Is the given block processed in phase A of the given stage? */
+      const auto in_phase_a = [&](const unsigned int block,
+                                  const unsigned int stage) {
+        return stage == 0 ||
+               (temporal_blocking_ && block_distances_[block] >= stage);
+      };
 
-        const Number m_i = lumped_mass_matrix.local_element(i);
-        const Number m_i_inv = lumped_mass_matrix_inverse.local_element(i);
+      {
+        Scope scope(computing_timer_,
+                    "time step 3-" + std::to_string(2 + n_stages) +
+                        " - l.-o. update, l_ij, and h.-o. update");
 
-        rank1_type r_i;
+        block_progress_.reset();
 
-        /* Clear bounds: */
-        limiter_serial.reset(variations_i);
+        if (early_sends)
+          start_receives(0);
 
-        const unsigned int *js = sparsity_simd.columns(i);
-        for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
-          const auto j = js[col_idx];
+        RYUJIN_PARALLEL_REGION_BEGIN
 
-          const auto U_j = U.get_tensor(j);
-          const auto alpha_j = alpha_.local_element(j);
-          const auto variations_j = second_variations_.local_element(j);
+        /* Nota bene: These variables are thread local: */
+        Limiter<dim, Number> limiter_serial;
+        Limiter<dim, VA> limiter_simd;
+        AlignedVector<Number> lij_row_serial;
+        AlignedVector<VectorizedArray<Number>> lij_row_simd;
+#ifdef RECOMPUTE_PIJ
+        AlignedVector<rank1_type> pij_row_serial;
+        AlignedVector<typename ProblemDescription<dim, VA>::rank1_type>
+            pij_row_simd;
+#endif
+        std::array<bool, n_stages> thread_ready{};
 
-          const auto d_ij = dij_matrix_.get_entry(i, col_idx);
-          const Number d_ij_inv = Number(1.) / d_ij;
+        /* Step 3, non-vectorized: */
+        const auto step_3_serial = [&](const unsigned int i) {
+          /* Skip constrained degrees of freedom */
+          const unsigned int row_length = sparsity_simd.row_length(i);
+          if (row_length == 1)
+            return;
 
-          const auto d_ijH = Indicator<dim, Number>::indicator_ ==
-                                     Indicator<dim, Number>::Indicators::
-                                         entropy_viscosity_commutator
-                                 ? d_ij * (alpha_i + alpha_j) * Number(.5)
-                                 : d_ij * std::max(alpha_i, alpha_j);
+          const auto U_i = U.get_tensor(i);
+#ifdef USE_PRECOMPUTED_FLUXES
+          const auto f_i = ProblemDescription<dim, Number>::f(
+              precomputed_values_.get_tensor(i));
+#else
+          const auto f_i = ProblemDescription<dim, Number>::f(U_i);
+#endif
+          /*
+           * For n_passes != 0 tau is not known yet (see above). We then
+           * only accumulate the low-order increment and apply it in Step 4:
+           */
+          auto U_i_new = (n_passes == 0 ? U_i : rank1_type());
+          const Number tau_i = (n_passes == 0 ? tau : Number(1.));
 
-          dealii::Tensor<1, problem_dimension, Number> U_ij_bar;
-          const auto c_ij = cij_matrix.get_tensor(i, col_idx);
-          const auto f_j = ProblemDescription<dim, Number>::f(U_j);
+          const auto alpha_i = alpha_.local_element(i);
+          const auto variations_i = second_variations_.local_element(i);
 
-          for (unsigned int k = 0; k < problem_dimension; ++k) {
-            const auto temp = (f_j[k] - f_i[k]) * c_ij;
+          const Number m_i = lumped_mass_matrix.local_element(i);
+          const Number m_i_inv = lumped_mass_matrix_inverse.local_element(i);
 
-            r_i[k] += -temp + d_ijH * (U_j - U_i)[k];
-            U_ij_bar[k] =
-                Number(0.5) * (U_i[k] + U_j[k]) - Number(0.5) * temp * d_ij_inv;
-          }
+          rank1_type r_i;
 
-          U_i_new += tau * m_i_inv * Number(2.) * d_ij * U_ij_bar;
+          /* Clear bounds: */
+          limiter_serial.reset(variations_i);
 
-          const auto beta_ij = betaij_matrix.get_entry(i, col_idx);
+          const unsigned int *js = sparsity_simd.columns(i);
+          for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+            const auto j = js[col_idx];
+
+            const auto U_j = U.get_tensor(j);
+            const auto alpha_j = alpha_.local_element(j);
+            const auto variations_j = second_variations_.local_element(j);
+
+            const auto d_ij = dij_matrix_.get_entry(i, col_idx);
+            const Number d_ij_inv = Number(1.) / d_ij;
+
+            const auto d_ijH = Indicator<dim, Number>::indicator_ ==
+                                       Indicator<dim, Number>::Indicators::
+                                           entropy_viscosity_commutator
+                                   ? d_ij * (alpha_i + alpha_j) * Number(.5)
+                                   : d_ij * std::max(alpha_i, alpha_j);
+
+            dealii::Tensor<1, problem_dimension, Number> U_ij_bar;
+            const auto c_ij = cij_matrix.get_tensor(i, col_idx);
+#ifdef USE_PRECOMPUTED_FLUXES
+            const auto f_j = ProblemDescription<dim, Number>::f(
+                precomputed_values_.get_tensor(j));
+#else
+            const auto f_j = ProblemDescription<dim, Number>::f(U_j);
+#endif
 
-          limiter_serial.accumulate(U_i,
-                                    U_j,
-                                    U_ij_bar,
-                                    beta_ij,
-                                    specific_entropies_.local_element(j),
-                                    variations_j,
-                                    /* is diagonal */ col_idx == 0);
-        }
+            for (unsigned int k = 0; k < problem_dimension; ++k) {
+              const auto temp = (f_j[k] - f_i[k]) * c_ij;
 
-        if constexpr (n_passes == 0) {
-          /* Fix up boundary: */
-          const auto it = boundary_map.find(i);
-          if (it != boundary_map.end()) {
-            const auto &[normal, id, position] = it->second;
-
-            /* On boundary 1 remove the normal component of the momentum: */
-            if (id == Boundary::slip) {
-              auto m = ProblemDescription<dim, Number>::momentum(U_i_new);
-              m -= 1. * (m * normal) * normal;
-              for (unsigned int k = 0; k < dim; ++k)
-                U_i_new[k + 1] = m[k];
+              r_i[k] += -temp + d_ijH * (U_j - U_i)[k];
+              U_ij_bar[k] = Number(0.5) * (U_i[k] + U_j[k]) -
+                            Number(0.5) * temp * d_ij_inv;
             }
 
-            /* On boundary 2 enforce initial conditions: */
-            if (id == Boundary::dirichlet) {
-              U_i_new = initial_values_->initial_state(position, t + tau);
+            if constexpr (reduced_precision) {
+              /*
+               * The diagonal d_ii is stored with reduced precision, so we
+               * use -sum_{j!=i} d_ij instead in order to retain
+               * conservation:
+               */
+              if (col_idx != 0)
+                U_i_new +=
+                    tau_i * m_i_inv * Number(2.) * d_ij * (U_ij_bar - U_i);
+            } else {
+              U_i_new += tau_i * m_i_inv * Number(2.) * d_ij * U_ij_bar;
             }
-          }
-        }
-
-        temp_euler_.write_tensor(U_i_new, i);
-        r_.write_tensor(r_i, i);
-
-        const Number hd_i = m_i * measure_of_omega_inverse;
-        limiter_serial.apply_relaxation(hd_i);
-        bounds_.write_tensor(limiter_serial.bounds(), i);
-      } /* parallel non-vectorized loop */
-
-      /* Nota bene: This bounds variable is thread local: */
-      Limiter<dim, VA> limiter_simd;
-      bool thread_ready = false;
-
-      /* Parallel SIMD loop: */
 
-      RYUJIN_OMP_FOR
-      for (unsigned int i = 0; i < n_internal; i += simd_length) {
+            const auto beta_ij = betaij_matrix.get_entry(i, col_idx);
 
-        synchronization_dispatch.check(thread_ready, i >= n_export_indices);
-
-        const auto U_i = U.get_vectorized_tensor(i);
-        const auto f_i = ProblemDescription<dim, VA>::f(U_i);
-        auto U_i_new = U_i;
-        const auto alpha_i = simd_load(alpha_, i);
-        const auto variations_i = simd_load(second_variations_, i);
-
-        const auto m_i = simd_load(lumped_mass_matrix, i);
-        const auto m_i_inv = simd_load(lumped_mass_matrix_inverse, i);
-
-        using PD = ProblemDescription<dim, VA>;
-        typename PD::rank1_type r_i;
-
-        /* Clear bounds: */
-        limiter_simd.reset(variations_i);
-
-        const unsigned int *js = sparsity_simd.columns(i);
-        const unsigned int row_length = sparsity_simd.row_length(i);
-
-        for (unsigned int col_idx = 0; col_idx < row_length;
-             ++col_idx, js += simd_length) {
-
-          const auto alpha_j = simd_load(alpha_, js);
-          const auto variations_j = simd_load(second_variations_, js);
-
-          const auto d_ij = dij_matrix_.get_vectorized_entry(i, col_idx);
-
-          const auto d_ijH = Indicator<dim, Number>::indicator_ ==
-                                     Indicator<dim, Number>::Indicators::
-                                         entropy_viscosity_commutator
-                                 ? d_ij * (alpha_i + alpha_j) * Number(.5)
-                                 : d_ij * std::max(alpha_i, alpha_j);
-
-          const auto U_j = U.get_vectorized_tensor(js);
-
-          dealii::Tensor<1, problem_dimension, VA> U_ij_bar;
-          const auto c_ij = cij_matrix.get_vectorized_tensor(i, col_idx);
-          const auto d_ij_inv = Number(1.) / d_ij;
-
-          const auto f_j = ProblemDescription<dim, VA>::f(U_j);
-          for (unsigned int k = 0; k < problem_dimension; ++k) {
-            const auto temp = (f_j[k] - f_i[k]) * c_ij;
-
-            r_i[k] += -temp + d_ijH * (U_j[k] - U_i[k]);
-            U_ij_bar[k] = Number(0.5) * (U_i[k] + U_j[k] - temp * d_ij_inv);
+            limiter_serial.accumulate(U_i,
+                                      U_j,
+                                      U_ij_bar,
+                                      beta_ij,
+                                      specific_entropies_.local_element(j),
+                                      variations_j,
+                                      /* is diagonal */ col_idx == 0);
           }
 
-          U_i_new += tau * m_i_inv * Number(2.) * d_ij * U_ij_bar;
-
-          const auto beta_ij = betaij_matrix.get_vectorized_entry(i, col_idx);
-          const auto entropy_j = simd_load(specific_entropies_, js);
-
-          limiter_simd.accumulate(U_i,
-                                  U_j,
-                                  U_ij_bar,
-                                  beta_ij,
-                                  entropy_j,
-                                  variations_j,
-                                  /* is diagonal */ col_idx == 0);
-        }
+          if constexpr (n_passes == 0) {
+            /* Fix up boundary: */
+            apply_boundary_conditions(i, U_i_new);
 
-        temp_euler_.write_vectorized_tensor(U_i_new, i);
-        r_.write_vectorized_tensor(r_i, i);
+            /* SSP convex combination: */
+            if (U_old != nullptr)
+              U_i_new = a * U_old->get_tensor(i) + b * U_i_new;
+          }
 
-        const auto hd_i = m_i * measure_of_omega_inverse;
-        limiter_simd.apply_relaxation(hd_i);
-        bounds_.write_vectorized_tensor(limiter_simd.bounds(), i);
-      } /* parallel SIMD loop */
+          temp_euler_.write_tensor(U_i_new, i);
+          r_.write_tensor(r_i, i);
 
-      LIKWID_MARKER_STOP("time_step_3");
-      RYUJIN_PARALLEL_REGION_END
-    }
+#ifdef USE_PRECOMPUTED_NORMALS
+          limiter_serial.apply_relaxation_with_radius(
+              relaxation_radii_.local_element(i));
+#else
+          const Number hd_i = m_i * measure_of_omega_inverse;
+          limiter_serial.apply_relaxation(hd_i);
+#endif
+          bounds_.write_tensor(limiter_serial.bounds(), i);
+        };
+
+        /* Step 3, vectorized: */
+        const auto step_3_simd = [&](const unsigned int i) {
+          const auto U_i = U.get_vectorized_tensor(i);
+#ifdef USE_PRECOMPUTED_FLUXES
+          const auto f_i = ProblemDescription<dim, VA>::f(
+              precomputed_values_.get_vectorized_tensor(i));
+#else
+          const auto f_i = ProblemDescription<dim, VA>::f(U_i);
+#endif
+          using PD = ProblemDescription<dim, VA>;
+          auto U_i_new = (n_passes == 0 ? U_i : typename PD::rank1_type());
+          const Number tau_i = (n_passes == 0 ? tau : Number(1.));
 
-    {
-      Scope scope(computing_timer_, "time step 3 - synchronization");
+          const auto alpha_i = simd_load(alpha_, i);
+          const auto variations_i = simd_load(second_variations_, i);
 
-      if constexpr (n_passes != 0) {
-      }
-      if (n_passes != 0) {
-        r_.update_ghost_values_finish();
-      } else {
-        /* If we do not do high-order, synchronize at this point: */
-        temp_euler_.update_ghost_values_finish();
-      }
-    }
+          const auto m_i = simd_load(lumped_mass_matrix, i);
+          const auto m_i_inv = simd_load(lumped_mass_matrix_inverse, i);
 
-    /*
-     * Step 4: Compute P_ij, and l_ij (first round):
-     *
-     *    P_ij = tau / m_i / lambda ( (d_ij^H - d_ij^L) (U_i - U_j) +
-     *                                (b_ij R_j - b_ji R_i) )
-     */
+          typename PD::rank1_type r_i;
 
-    if constexpr (n_passes != 0) {
-      Scope scope(computing_timer_, "time step 4 - compute p_ij, and l_ij");
+          /* Clear bounds: */
+          limiter_simd.reset(variations_i);
 
-      SynchronizationDispatch synchronization_dispatch(
-          [&]() { lij_matrix_.update_ghost_rows_start(channel++); });
+          const unsigned int *js = sparsity_simd.columns(i);
+          const unsigned int row_length = sparsity_simd.row_length(i);
 
-      RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START("time_step_4");
+          for (unsigned int col_idx = 0; col_idx < row_length;
+               ++col_idx, js += simd_length) {
 
-      /* Parallel non-vectorized loop: */
+            const auto alpha_j = simd_load(alpha_, js);
+            const auto variations_j = simd_load(second_variations_, js);
 
-      RYUJIN_OMP_FOR_NOWAIT
-      for (unsigned int i = n_internal; i < n_owned; ++i) {
+            const auto d_ij = dij_matrix_.get_vectorized_entry(i, col_idx);
 
-        /* Skip constrained degrees of freedom */
-        const unsigned int row_length = sparsity_simd.row_length(i);
-        if (row_length == 1)
-          continue;
+            const auto d_ijH = Indicator<dim, Number>::indicator_ ==
+                                       Indicator<dim, Number>::Indicators::
+                                           entropy_viscosity_commutator
+                                   ? d_ij * (alpha_i + alpha_j) * Number(.5)
+                                   : d_ij * std::max(alpha_i, alpha_j);
 
-        const auto bounds =
-            bounds_.template get_tensor<std::array<Number, 3>>(i);
+            const auto U_j = U.get_vectorized_tensor(js);
 
-        const auto U_i_new = temp_euler_.get_tensor(i);
-        const auto U_i = U.get_tensor(i);
-        const auto r_i = r_.get_tensor(i);
+            dealii::Tensor<1, problem_dimension, VA> U_ij_bar;
+            const auto c_ij = cij_matrix.get_vectorized_tensor(i, col_idx);
+            const auto d_ij_inv = Number(1.) / d_ij;
 
-        const auto alpha_i = alpha_.local_element(i);
-        const Number m_i_inv = lumped_mass_matrix_inverse.local_element(i);
+#ifdef USE_PRECOMPUTED_FLUXES
+            const auto f_j = ProblemDescription<dim, VA>::f(
+                precomputed_values_.get_vectorized_tensor(js));
+#else
+            const auto f_j = ProblemDescription<dim, VA>::f(U_j);
+#endif
+            for (unsigned int k = 0; k < problem_dimension; ++k) {
+              const auto temp = (f_j[k] - f_i[k]) * c_ij;
 
-        const unsigned int *js = sparsity_simd.columns(i);
-        const Number lambda_inv = Number(row_length - 1);
+              r_i[k] += -temp + d_ijH * (U_j[k] - U_i[k]);
+              U_ij_bar[k] = Number(0.5) * (U_i[k] + U_j[k] - temp * d_ij_inv);
+            }
 
-        for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
-          const auto j = js[col_idx];
+            if constexpr (reduced_precision) {
+              /*
+               * The diagonal d_ii is stored with reduced precision, so we
+               * use -sum_{j!=i} d_ij instead in order to retain
+               * conservation:
+               */
+              if (col_idx != 0)
+                U_i_new +=
+                    tau_i * m_i_inv * Number(2.) * d_ij * (U_ij_bar - U_i);
+            } else {
+              U_i_new += tau_i * m_i_inv * Number(2.) * d_ij * U_ij_bar;
+            }
 
-          const auto U_j = U.get_tensor(j);
+            const auto beta_ij = betaij_matrix.get_vectorized_entry(i, col_idx);
+            const auto entropy_j = simd_load(specific_entropies_, js);
 
-          const auto r_j = r_.get_tensor(j);
+            limiter_simd.accumulate(U_i,
+                                    U_j,
+                                    U_ij_bar,
+                                    beta_ij,
+                                    entropy_j,
+                                    variations_j,
+                                    /* is diagonal */ col_idx == 0);
+          }
 
-          const auto alpha_j = alpha_.local_element(j);
-          const Number m_j_inv = lumped_mass_matrix_inverse.local_element(j);
+          if constexpr (n_passes == 0) {
+            /* Fix up boundary: */
+            apply_boundary_conditions_simd(i, U_i_new);
 
-          const auto d_ij = dij_matrix_.get_entry(i, col_idx);
-          const auto d_ijH = Indicator<dim, Number>::indicator_ ==
-                                     Indicator<dim, Number>::Indicators::
-                                         entropy_viscosity_commutator
-                                 ? d_ij * (alpha_i + alpha_j) * Number(.5)
-                                 : d_ij * std::max(alpha_i, alpha_j);
+            /* SSP convex combination: */
+            if (U_old != nullptr)
+              U_i_new = a * U_old->get_vectorized_tensor(i) + b * U_i_new;
+          }
 
-          const auto m_ij = mass_matrix.get_entry(i, col_idx);
-          const auto b_ij =
-              (col_idx == 0 ? Number(1.) : Number(0.)) - m_ij * m_j_inv;
-          const auto b_ji =
-              (col_idx == 0 ? Number(1.) : Number(0.)) - m_ij * m_i_inv;
+          temp_euler_.write_vectorized_tensor(U_i_new, i);
+          r_.write_vectorized_tensor(r_i, i);
 
-          const auto p_ij =
-              tau * m_i_inv * lambda_inv *
-              ((d_ijH - d_ij) * (U_j - U_i) + b_ij * r_j - b_ji * r_i);
-          pij_matrix_.write_tensor(p_ij, i, col_idx);
+#ifdef USE_PRECOMPUTED_NORMALS
+          limiter_simd.apply_relaxation_with_radius(
+              simd_load(relaxation_radii_, i));
+#else
+          const auto hd_i = m_i * measure_of_omega_inverse;
+          limiter_simd.apply_relaxation(hd_i);
+#endif
+          bounds_.write_vectorized_tensor(limiter_simd.bounds(), i);
+        };
 
-          const auto l_ij = Limiter<dim, Number>::limit(bounds, U_i_new, p_ij);
-          lij_matrix_.write_entry(l_ij, i, col_idx);
-        }
-      } /* parallel non-vectorized loop */
+        /* Step 4, non-vectorized: */
+        const auto step_4_serial = [&](const unsigned int i) {
+          /* Skip constrained degrees of freedom */
+          const unsigned int row_length = sparsity_simd.row_length(i);
+          if (row_length == 1)
+            return;
 
-      /* Parallel SIMD loop: */
+          const auto bounds =
+              bounds_.template get_tensor<std::array<Number, 3>>(i);
 
-      bool thread_ready = false;
+          /* Apply the low-order increment computed in Step 3: */
+          const auto U_i = U.get_tensor(i);
+          const auto U_i_new = U_i + tau * temp_euler_.get_tensor(i);
+          temp_euler_.write_tensor(U_i_new, i);
 
-      RYUJIN_OMP_FOR
-      for (unsigned int i = 0; i < n_internal; i += simd_length) {
+          const auto r_i = r_.get_tensor(i);
 
-        synchronization_dispatch.check(thread_ready, i >= n_export_indices);
+          const auto alpha_i = alpha_.local_element(i);
+          const Number m_i_inv = lumped_mass_matrix_inverse.local_element(i);
 
-        const auto bounds =
-            bounds_.template get_vectorized_tensor<std::array<VA, 3>>(i);
+          const unsigned int *js = sparsity_simd.columns(i);
+          const Number lambda_inv = Number(row_length - 1);
 
-        const auto m_i_inv = simd_load(lumped_mass_matrix_inverse, i);
+          for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+            const auto j = js[col_idx];
 
-        const unsigned int row_length = sparsity_simd.row_length(i);
-        const VA lambda_inv = Number(row_length - 1);
+            const auto U_j = U.get_tensor(j);
 
-        const auto U_i_new = temp_euler_.get_vectorized_tensor(i);
-        const auto U_i = U.get_vectorized_tensor(i);
-        const auto r_i = r_.get_vectorized_tensor(i);
-        const auto alpha_i = simd_load(alpha_, i);
+            const auto r_j = r_.get_tensor(j);
 
-        const unsigned int *js = sparsity_simd.columns(i);
+            const auto alpha_j = alpha_.local_element(j);
+            const Number m_j_inv = lumped_mass_matrix_inverse.local_element(j);
 
-        for (unsigned int col_idx = 0; col_idx < row_length;
-             ++col_idx, js += simd_length) {
+            const auto d_ij = dij_matrix_.get_entry(i, col_idx);
+            const auto d_ijH = Indicator<dim, Number>::indicator_ ==
+                                       Indicator<dim, Number>::Indicators::
+                                           entropy_viscosity_commutator
+                                   ? d_ij * (alpha_i + alpha_j) * Number(.5)
+                                   : d_ij * std::max(alpha_i, alpha_j);
 
-          const auto m_j_inv = simd_load(lumped_mass_matrix_inverse, js);
+            const auto m_ij = mass_matrix.get_entry(i, col_idx);
+            const auto b_ij =
+                (col_idx == 0 ? Number(1.) : Number(0.)) - m_ij * m_j_inv;
+            const auto b_ji =
+                (col_idx == 0 ? Number(1.) : Number(0.)) - m_ij * m_i_inv;
 
-          const auto alpha_j = simd_load(alpha_, js);
+            const auto p_ij =
+                tau * m_i_inv * lambda_inv *
+                ((d_ijH - d_ij) * (U_j - U_i) + b_ij * r_j - b_ji * r_i);
+#ifndef RECOMPUTE_PIJ
+            pij_matrix_.write_tensor(p_ij, i, col_idx);
+#endif
 
-          const auto d_ij = dij_matrix_.get_vectorized_entry(i, col_idx);
+            const auto l_ij =
+                Limiter<dim, Number>::limit(bounds, U_i_new, p_ij);
+            lij_matrix_.write_entry(round_down(l_ij), i, col_idx);
+          }
+        };
 
-          const auto d_ijH = Indicator<dim, Number>::indicator_ ==
-                                     Indicator<dim, Number>::Indicators::
-                                         entropy_viscosity_commutator
-                                 ? d_ij * (alpha_i + alpha_j) * Number(.5)
-                                 : d_ij * std::max(alpha_i, alpha_j);
+        /* Step 4, vectorized: */
+        const auto step_4_simd = [&](const unsigned int i) {
+          const auto bounds =
+              bounds_.template get_vectorized_tensor<std::array<VA, 3>>(i);
 
-          const auto m_ij = mass_matrix.get_vectorized_entry(i, col_idx);
-          const auto b_ij = (col_idx == 0 ? VA(1.) : VA(0.)) - m_ij * m_j_inv;
-          const auto b_ji = (col_idx == 0 ? VA(1.) : VA(0.)) - m_ij * m_i_inv;
+          const auto m_i_inv = simd_load(lumped_mass_matrix_inverse, i);
 
-          const auto U_j = U.get_vectorized_tensor(js);
-          const auto r_j = r_.get_vectorized_tensor(js);
+          const unsigned int row_length = sparsity_simd.row_length(i);
+          const VA lambda_inv = Number(row_length - 1);
 
-          const auto p_ij =
-              tau * m_i_inv * lambda_inv *
-              ((d_ijH - d_ij) * (U_j - U_i) + b_ij * r_j - b_ji * r_i);
-          pij_matrix_.write_vectorized_tensor(p_ij, i, col_idx, true);
+          /* Apply the low-order increment computed in Step 3: */
+          const auto U_i = U.get_vectorized_tensor(i);
+          const auto U_i_new = U_i + tau * temp_euler_.get_vectorized_tensor(i);
+          temp_euler_.write_vectorized_tensor(U_i_new, i);
 
-          const auto l_ij = Limiter<dim, VA>::limit(bounds, U_i_new, p_ij);
+          const auto r_i = r_.get_vectorized_tensor(i);
+          const auto alpha_i = simd_load(alpha_, i);
 
-          lij_matrix_.write_vectorized_entry(l_ij, i, col_idx, true);
-        }
-      } /* parallel SIMD loop */
+          const unsigned int *js = sparsity_simd.columns(i);
 
-      LIKWID_MARKER_STOP("time_step_4");
-      RYUJIN_PARALLEL_REGION_END
-    }
+          for (unsigned int col_idx = 0; col_idx < row_length;
+               ++col_idx, js += simd_length) {
 
-    if constexpr (n_passes != 0) {
-      Scope scope(computing_timer_, "time step 4 - synchronization");
+            const auto m_j_inv = simd_load(lumped_mass_matrix_inverse, js);
 
-      lij_matrix_.update_ghost_rows_finish();
-    }
+            const auto alpha_j = simd_load(alpha_, js);
 
-    /*
-     * Step 5, 6, ..., 4 + n_passes: Perform high-order update:
-     *
-     *   Symmetrize l_ij
-     *   High-order update: += l_ij * lambda * P_ij
-     *   Compute next l_ij
-     */
+            const auto d_ij = dij_matrix_.get_vectorized_entry(i, col_idx);
 
-    for (unsigned int pass = 0; pass < n_passes; ++pass) {
+            const auto d_ijH = Indicator<dim, Number>::indicator_ ==
+                                       Indicator<dim, Number>::Indicators::
+                                           entropy_viscosity_commutator
+                                   ? d_ij * (alpha_i + alpha_j) * Number(.5)
+                                   : d_ij * std::max(alpha_i, alpha_j);
 
-      std::string step_no = std::to_string(5 + pass);
-      std::string additional_step = pass + 1 < n_passes ? ", next l_ij" : "";
-      bool last_round = (pass + 1 == n_passes);
+            const auto m_ij = mass_matrix.get_vectorized_entry(i, col_idx);
+            const auto b_ij = (col_idx == 0 ? VA(1.) : VA(0.)) - m_ij * m_j_inv;
+            const auto b_ji = (col_idx == 0 ? VA(1.) : VA(0.)) - m_ij * m_i_inv;
 
-      {
-        Scope scope(computing_timer_,
-                    "time step " + step_no + " - " +
-                        "symmetrize l_ij, h.-o. update" + additional_step);
+            const auto U_j = U.get_vectorized_tensor(js);
+            const auto r_j = r_.get_vectorized_tensor(js);
 
-        SynchronizationDispatch synchronization_dispatch([&]() {
-          if (last_round)
-            temp_euler_.update_ghost_values_start(channel++);
-          else
-            lij_matrix_next_.update_ghost_rows_start(channel++);
-        });
+            const auto p_ij =
+                tau * m_i_inv * lambda_inv *
+                ((d_ijH - d_ij) * (U_j - U_i) + b_ij * r_j - b_ji * r_i);
+#ifndef RECOMPUTE_PIJ
+            pij_matrix_.write_vectorized_tensor(p_ij, i, col_idx, true);
+#endif
 
-        RYUJIN_PARALLEL_REGION_BEGIN
-        LIKWID_MARKER_START(("time_step_" + step_no).c_str());
+            const auto l_ij = Limiter<dim, VA>::limit(bounds, U_i_new, p_ij);
 
-        /* Stored thread locally: */
-        AlignedVector<Number> lij_row_serial;
+            lij_matrix_.write_vectorized_entry(
+                round_down(l_ij), i, col_idx, true);
+          }
+        };
 
-        /* Parallel non-vectorized loop: */
-        RYUJIN_OMP_FOR_NOWAIT
-        for (unsigned int i = n_internal; i < n_owned; ++i) {
+        /* Step 5 + pass, non-vectorized: */
+        const auto pass_serial = [&](const unsigned int pass,
+                                     const unsigned int i) {
+          auto &lij_current = *lij[pass % 2];
+          auto &lij_next = *lij[(pass + 1) % 2];
+          const bool last_round = (pass + 1 == n_passes);
 
           /* Skip constrained degrees of freedom */
           const unsigned int row_length = sparsity_simd.row_length(i);
           if (row_length == 1)
-            continue;
+            return;
 
           lij_row_serial.resize_fast(row_length);
 
@@ -838,12 +1830,55 @@ namespace ryujin
 
           const Number lambda = Number(1.) / Number(row_length - 1);
 
+#ifdef RECOMPUTE_PIJ
+          pij_row_serial.resize_fast(row_length);
+
+          const auto U_i = U.get_tensor(i);
+          const auto r_i = r_.get_tensor(i);
+
+          const auto alpha_i = alpha_.local_element(i);
+          const Number m_i_inv = lumped_mass_matrix_inverse.local_element(i);
+
+          const unsigned int *js = sparsity_simd.columns(i);
+          const Number lambda_inv = Number(row_length - 1);
+#endif
+
           for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+#ifdef RECOMPUTE_PIJ
+            const auto j = js[col_idx];
+
+            const auto U_j = U.get_tensor(j);
+            const auto r_j = r_.get_tensor(j);
+
+            const auto alpha_j = alpha_.local_element(j);
+            const Number m_j_inv = lumped_mass_matrix_inverse.local_element(j);
+
+            const auto d_ij = dij_matrix_.get_entry(i, col_idx);
+            const auto d_ijH = Indicator<dim, Number>::indicator_ ==
+                                       Indicator<dim, Number>::Indicators::
+                                           entropy_viscosity_commutator
+                                   ? d_ij * (alpha_i + alpha_j) * Number(.5)
+                                   : d_ij * std::max(alpha_i, alpha_j);
+
+            const auto m_ij = mass_matrix.get_entry(i, col_idx);
+            const auto b_ij =
+                (col_idx == 0 ? Number(1.) : Number(0.)) - m_ij * m_j_inv;
+            const auto b_ji =
+                (col_idx == 0 ? Number(1.) : Number(0.)) - m_ij * m_i_inv;
+
+            const auto p_ij =
+                tau * m_i_inv * lambda_inv *
+                ((d_ijH - d_ij) * (U_j - U_i) + b_ij * r_j - b_ji * r_i);
+
+            if (!last_round)
+              pij_row_serial[col_idx] = p_ij;
+#else
             auto p_ij = pij_matrix_.get_tensor(i, col_idx);
+#endif
 
             const auto l_ij =
-                std::min(lij_matrix_.get_entry(i, col_idx),
-                         lij_matrix_.get_transposed_entry(i, col_idx));
+                std::min(lij_current.get_entry(i, col_idx),
+                         lij_current.get_transposed_entry(i, col_idx));
 
             U_i_new += l_ij * lambda * p_ij;
 
@@ -854,23 +1889,11 @@ namespace ryujin
           /* In the last round */
           if (last_round) {
             /* Fix up boundary: */
-            const auto it = boundary_map.find(i);
-            if (it != boundary_map.end()) {
-              const auto &[normal, id, position] = it->second;
-
-              /* On boundary 1 remove the normal component of the momentum: */
-              if (id == Boundary::slip) {
-                auto m = ProblemDescription<dim, Number>::momentum(U_i_new);
-                m -= 1. * (m * normal) * normal;
-                for (unsigned int k = 0; k < dim; ++k)
-                  U_i_new[k + 1] = m[k];
-              }
+            apply_boundary_conditions(i, U_i_new);
 
-              /* On boundary 2 enforce initial conditions: */
-              if (id == Boundary::dirichlet) {
-                U_i_new = initial_values_->initial_state(position, t + tau);
-              }
-            }
+            /* SSP convex combination: */
+            if (U_old != nullptr)
+              U_i_new = a * U_old->get_tensor(i) + b * U_i_new;
           }
 
 #ifdef CHECK_BOUNDS
@@ -900,15 +1923,20 @@ namespace ryujin
 
           /* Skip computating l_ij and updating p_ij in the last round */
           if (last_round)
-            continue;
+            return;
 
           const auto bounds =
               bounds_.template get_tensor<std::array<Number, 3>>(i);
 
           for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
             const auto old_l_ij = lij_row_serial[col_idx];
+#ifdef RECOMPUTE_PIJ
+            const auto new_p_ij =
+                (Number(1.) - old_l_ij) * pij_row_serial[col_idx];
+#else
             const auto new_p_ij =
                 (Number(1.) - old_l_ij) * pij_matrix_.get_tensor(i, col_idx);
+#endif
 
             const auto new_l_ij =
                 Limiter<dim, Number>::limit(bounds, U_i_new, new_p_ij);
@@ -919,29 +1947,28 @@ namespace ryujin
                * write (1 - l_ij^(1)) * l_ij^(2) into the l_ij matrix. This
                * approach only works for two limiting steps.
                */
-              lij_matrix_next_.write_entry(
-                  (Number(1.) - old_l_ij) * new_l_ij, i, col_idx);
+              lij_next.write_entry(
+                  round_down((Number(1.) - old_l_ij) * new_l_ij), i, col_idx);
             } else {
               /*
                * @todo: This is expensive. If we ever end up using more
                * than two limiter passes we should implement this by
                * storing a scalar factor instead of writing back into p_ij.
                */
-              lij_matrix_next_.write_entry(new_l_ij, i, col_idx);
+              lij_next.write_entry(round_down(new_l_ij), i, col_idx);
+#ifndef RECOMPUTE_PIJ
               pij_matrix_.write_tensor(new_p_ij, i, col_idx);
+#endif
             }
           }
-        } /* parallel non-vectorized loop */
+        };
 
-        /* Stored thread locally: */
-        AlignedVector<VectorizedArray<Number>> lij_row_simd;
-        bool thread_ready = false;
-
-        /* Parallel vectorized loop: */
-        RYUJIN_OMP_FOR
-        for (unsigned int i = 0; i < n_internal; i += simd_length) {
-
-          synchronization_dispatch.check(thread_ready, i >= n_export_indices);
+        /* Step 5 + pass, vectorized: */
+        const auto pass_simd = [&](const unsigned int pass,
+                                   const unsigned int i) {
+          auto &lij_current = *lij[pass % 2];
+          auto &lij_next = *lij[(pass + 1) % 2];
+          const bool last_round = (pass + 1 == n_passes);
 
           auto U_i_new = temp_euler_.get_vectorized_tensor(i);
 
@@ -949,13 +1976,56 @@ namespace ryujin
           const Number lambda = Number(1.) / Number(row_length - 1);
           lij_row_simd.resize_fast(row_length);
 
+#ifdef RECOMPUTE_PIJ
+          pij_row_simd.resize_fast(row_length);
+
+          const auto m_i_inv = simd_load(lumped_mass_matrix_inverse, i);
+          const VA lambda_inv = Number(row_length - 1);
+
+          const auto U_i = U.get_vectorized_tensor(i);
+          const auto r_i = r_.get_vectorized_tensor(i);
+          const auto alpha_i = simd_load(alpha_, i);
+
+          const unsigned int *js = sparsity_simd.columns(i);
+#endif
+
           for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
 
             const auto l_ij = std::min(
-                lij_matrix_.get_vectorized_entry(i, col_idx),
-                lij_matrix_.get_vectorized_transposed_entry(i, col_idx));
+                lij_current.get_vectorized_entry(i, col_idx),
+                lij_current.get_vectorized_transposed_entry(i, col_idx));
+
+#ifdef RECOMPUTE_PIJ
+            const auto m_j_inv = simd_load(lumped_mass_matrix_inverse, js);
+            const auto alpha_j = simd_load(alpha_, js);
+
+            const auto d_ij = dij_matrix_.get_vectorized_entry(i, col_idx);
+
+            const auto d_ijH = Indicator<dim, Number>::indicator_ ==
+                                       Indicator<dim, Number>::Indicators::
+                                           entropy_viscosity_commutator
+                                   ? d_ij * (alpha_i + alpha_j) * Number(.5)
+                                   : d_ij * std::max(alpha_i, alpha_j);
 
+            const auto m_ij = mass_matrix.get_vectorized_entry(i, col_idx);
+            const auto b_ij =
+                (col_idx == 0 ? VA(1.) : VA(0.)) - m_ij * m_j_inv;
+            const auto b_ji =
+                (col_idx == 0 ? VA(1.) : VA(0.)) - m_ij * m_i_inv;
+
+            const auto U_j = U.get_vectorized_tensor(js);
+            const auto r_j = r_.get_vectorized_tensor(js);
+            js += simd_length;
+
+            const auto p_ij =
+                tau * m_i_inv * lambda_inv *
+                ((d_ijH - d_ij) * (U_j - U_i) + b_ij * r_j - b_ji * r_i);
+
+            if (!last_round)
+              pij_row_simd[col_idx] = p_ij;
+#else
             auto p_ij = pij_matrix_.get_vectorized_tensor(i, col_idx);
+#endif
 
             U_i_new += l_ij * lambda * p_ij;
 
@@ -963,6 +2033,16 @@ namespace ryujin
               lij_row_simd[col_idx] = l_ij;
           }
 
+          /* In the last round */
+          if (last_round) {
+            /* Fix up boundary: */
+            apply_boundary_conditions_simd(i, U_i_new);
+
+            /* SSP convex combination: */
+            if (U_old != nullptr)
+              U_i_new = a * U_old->get_vectorized_tensor(i) + b * U_i_new;
+          }
+
 #ifdef CHECK_BOUNDS
           using PD = ProblemDescription<dim, VA>;
           const auto rho_new = U_i_new[0];
@@ -988,7 +2068,7 @@ namespace ryujin
 
           /* Skip computating l_ij and updating p_ij in the last round */
           if (last_round)
-            continue;
+            return;
 
           const auto bounds =
               bounds_.template get_vectorized_tensor<std::array<VA, 3>>(i);
@@ -996,8 +2076,12 @@ namespace ryujin
 
             const auto old_l_ij = lij_row_simd[col_idx];
 
+#ifdef RECOMPUTE_PIJ
+            const auto new_p_ij = (VA(1.) - old_l_ij) * pij_row_simd[col_idx];
+#else
             const auto new_p_ij = (VA(1.) - old_l_ij) *
                                   pij_matrix_.get_vectorized_tensor(i, col_idx);
+#endif
 
             const auto new_l_ij =
                 Limiter<dim, VA>::limit(bounds, U_i_new, new_p_ij);
@@ -1008,41 +2092,214 @@ namespace ryujin
                * write (1 - l_ij^(1)) * l_ij^(2) into the l_ij matrix. This
                * approach only works for two limiting steps.
                */
-              const auto entry =
-                  (VectorizedArray<Number>(1.) - old_l_ij) * new_l_ij;
-              lij_matrix_next_.write_vectorized_entry(entry, i, col_idx, true);
+              const auto entry = round_down(
+                  (VectorizedArray<Number>(1.) - old_l_ij) * new_l_ij);
+              lij_next.write_vectorized_entry(entry, i, col_idx, true);
             } else {
               /*
                * @todo: This is expensive. If we ever end up using more
                * than two limiter passes we should implement this by
                * storing a scalar factor instead of writing back into p_ij.
                */
-              lij_matrix_next_.write_vectorized_entry(
-                  new_l_ij, i, col_idx, true);
+              lij_next.write_vectorized_entry(
+                  round_down(new_l_ij), i, col_idx, true);
+#ifndef RECOMPUTE_PIJ
               pij_matrix_.write_vectorized_tensor(new_p_ij, i, col_idx);
+#endif
             }
           }
+        };
+
+        /*
+         * Process all blocks of the given stage that belong to the given
+         * phase. In phase A we wait for the completion of the previous
+         * stage on all block dependencies; in phase B this is guaranteed
+         * by the preceding thread synchronization barrier. In phase A
+         * the exported rows of a stage s > 0 are not processed, we thus
+         * only signal readiness for the halo exchange in phase B.
+         */
+        const auto run_stage = [&](const unsigned int stage,
+                                   const bool phase_a) {
+          const std::string marker = "time_step_" + std::to_string(3 + stage);
+          LIKWID_MARKER_START(marker.c_str());
+
+          auto &statistics = statistics_of(stage);
+          statistics.begin();
+
+          const bool signal = (stage == 0 || !phase_a);
+
+          /* Signal readiness of the SIMD row group or row i: */
+          const auto check = [&](const unsigned int i) {
+            if (!signal)
+              return;
+            if (early_sends) {
+              if (i >= n_internal || i < n_export_indices)
+                chunked_dispatches[stage].check(
+                    i < n_internal ? i / simd_length
+                                   : n_internal / simd_length +
+                                         (i - n_internal));
+            } else if (i < n_internal) {
+              synchronization_dispatches[stage].check(thread_ready[stage],
+                                                      i >= n_export_indices);
+            }
+          };
+
+          /* Parallel non-vectorized loop: */
+          RYUJIN_OMP_FOR_DYNAMIC_NOWAIT(1)
+          for (unsigned int block = n_blocks_simd_; block < n_blocks_owned_;
+               ++block) {
+            if (in_phase_a(block, stage) != phase_a)
+              continue;
+
+            if (phase_a && stage != 0) {
+              wait_for_tau(statistics);
+              wait_for_dependencies(statistics, block, stage);
+            }
+
+            /* Refused update: only record progress for other blocks: */
+            if (stage != 0 && !tau_accepted) {
+              if (phase_a)
+                block_progress_.mark(block, stage + 1);
+              continue;
+            }
+
+            for (unsigned int i = block_starts_[block];
+                 i < block_starts_[block + 1];
+                 ++i) {
+              if (stage == 0)
+                step_3_serial(i);
+              else if (stage == 1)
+                step_4_serial(i);
+              else
+                pass_serial(stage - 2, i);
+
+              if (early_sends)
+                check(i);
+            }
+
+            if (phase_a)
+              block_progress_.mark(block, stage + 1);
+
+            if (stage == 0)
+              progress_tau_reduction();
+          }
+
+          /* Parallel SIMD loop: */
+          RYUJIN_OMP_FOR_DYNAMIC_NOWAIT(1)
+          for (unsigned int block = 0; block < n_blocks_simd_; ++block) {
+            if (in_phase_a(block, stage) != phase_a)
+              continue;
+
+            if (phase_a && stage != 0) {
+              wait_for_tau(statistics);
+              wait_for_dependencies(statistics, block, stage);
+            }
+
+            /* Refused update: only record progress for other blocks: */
+            if (stage != 0 && !tau_accepted) {
+              if (phase_a)
+                block_progress_.mark(block, stage + 1);
+              continue;
+            }
+
+            for (unsigned int i = block_starts_[block];
+                 i < block_starts_[block + 1];
+                 i += simd_length) {
+              if (!early_sends)
+                check(i);
+
+              if (stage == 0)
+                step_3_simd(i);
+              else if (stage == 1)
+                step_4_simd(i);
+              else
+                pass_simd(stage - 2, i);
+
+              if (early_sends)
+                check(i);
+            }
+
+            if (phase_a)
+              block_progress_.mark(block, stage + 1);
+
+            if (stage == 0)
+              progress_tau_reduction();
+          }
+
+          statistics.end();
+          LIKWID_MARKER_STOP(marker.c_str());
+        };
+
+        /*
+         * Wait for all threads, complete the halo exchange of the given
+         * stage, and wait again before any thread reads ghost values. The
+         * reduction of tau_max is completed at the latest after Step 3:
+         */
+        const auto synchronize = [&](const unsigned int stage) {
+          auto &statistics = statistics_of(stage);
+          statistics.begin();
+          statistics.wait([&]() {
+            RYUJIN_OMP_BARRIER
+            RYUJIN_OMP_SINGLE
+            {
+              if (!tau_complete.load(std::memory_order_acquire)) {
+                complete_tau_reduction();
+                tau_complete.store(true, std::memory_order_release);
+              }
+              flush_dispatch(stage);
+              finish_exchange(stage);
+              if (early_sends && stage + 1 < n_stages)
+                start_receives(stage + 1);
+            }
+          });
+          statistics.end();
+        };
+
+        /* Phase A, Step 3: */
+        run_stage(0, true);
+
+        /*
+         * Phase A, all remaining stages: Blocks continue into Step 4 as
+         * soon as tau is known and their dependencies are met:
+         */
+        if (temporal_blocking_)
+          for (unsigned int stage = 1; stage < n_stages; ++stage)
+            run_stage(stage, true);
+
+        /*
+         * Phase B: If the update is refused we still complete all halo
+         * exchanges in order to not leave pending MPI requests behind:
+         */
+        for (unsigned int stage = 1; stage < n_stages; ++stage) {
+          synchronize(stage - 1);
+          if (tau_accepted)
+            run_stage(stage, false);
         }
 
-        LIKWID_MARKER_STOP(("time_step_" + step_no).c_str());
+        auto &statistics = statistics_of(n_stages - 1);
+        statistics.begin();
+        statistics.barrier();
+
         RYUJIN_PARALLEL_REGION_END
       }
 
       {
         Scope scope(computing_timer_,
-                    "time step " + step_no + " - synchronization");
+                    "time step " + std::to_string(2 + n_stages) +
+                        " - synchronization");
 
-        if (last_round)
-          temp_euler_.update_ghost_values_finish();
-        else {
-          lij_matrix_next_.update_ghost_rows_finish();
-          std::swap(lij_matrix_, lij_matrix_next_);
-        }
+        flush_dispatch(n_stages - 1);
+        finish_exchange(n_stages - 1);
       }
-    } /* limiter_iter_ */
+    }
+
+    if constexpr (n_passes != 0) {
+      if (!check_tau())
+        return tau_max;
+    }
 
     /* And finally update the result: */
-    U.swap(temp_euler_);
+    U_new.swap(temp_euler_);
 
     CALLGRIND_STOP_INSTRUMENTATION
 
@@ -1051,43 +2308,123 @@ namespace ryujin
 
 
   template <int dim, typename Number>
-  Number EulerModule<dim, Number>::ssph2_step(vector_type &U, Number t)
+  void EulerModule<dim, Number>::begin_step()
+  {
+    tau_ratio_ = Number(1.);
+    n_stages_ = 0;
+    attempt_timer_.restart();
+  }
+
+
+  template <int dim, typename Number>
+  Number EulerModule<dim, Number>::propose_tau(const Number tau_max,
+                                               const Number tau_0)
+  {
+    AssertThrow(tau_max * cfl_max_ / cfl_update_ >= tau_0,
+                ExcMessage("failed to recover from CFL violation"));
+
+    tau_max_first_stage_ = tau_max;
+    n_stages_ = 1;
+
+    /* For tau_0 == 0 euler_step() has used the same scaled step size: */
+    return (tau_0 == Number(0.) ? tau_factor_ * tau_max : tau_0);
+  }
+
+
+  template <int dim, typename Number>
+  bool EulerModule<dim, Number>::restart_required(const Number tau_max,
+                                                  const Number tau,
+                                                  Number &tau_0)
   {
+    AssertThrow(tau_max * cfl_max_ / cfl_update_ >= tau_0,
+                ExcMessage("failed to recover from CFL violation"));
+
+    ++n_stages_;
+
+    /* The largest scaling factor that would not have caused a restart: */
+    const Number ratio =
+        tau_max * cfl_max_ / (cfl_update_ * tau_max_first_stage_);
+    tau_ratio_ = std::min(tau_ratio_, ratio);
+
+    if (tau_max * cfl_max_ / cfl_update_ >= tau)
+      return false;
+
+    /* Restart and force smaller time step: */
 #ifdef DEBUG_OUTPUT
-    std::cout << "EulerModule<dim, Number>::ssph2_step()" << std::endl;
+    std::cout << "        insufficient step size, restart" << std::endl;
 #endif
+    tau_0 = tau_max;
+    ++n_restarts_;
+    n_wasted_stages_ += n_stages_;
+    wasted_time_ += attempt_timer_.wall_time();
+    attempt_timer_.restart();
 
-    Number tau_0 = 0.;
+    /* Do not wait for the end of the step to shrink the scaling factor: */
+    if (tau_controller_history_ > 0)
+      tau_factor_ = std::min(tau_factor_, tau_controller_safety_ * ratio);
 
-  restart_ssph2_step:
-    /* This also copies ghost elements: */
-    temp_ssp_ = U;
+    return true;
+  }
 
-    /* Step 1: U1 = U_old + tau * L(U_old) */
-    Number tau_1 = euler_step(U, t, tau_0);
 
-    AssertThrow(tau_1 * cfl_max_ / cfl_update_ >= tau_0,
-                ExcMessage("failed to recover from CFL violation"));
-    tau_1 = (tau_0 == 0. ? tau_1 : tau_0);
+  template <int dim, typename Number>
+  void EulerModule<dim, Number>::accept_step()
+  {
+    if (tau_controller_history_ == 0)
+      return;
 
-    /* Step 2: U2 = 1/2 U_old + 1/2 (U1 + tau L(U1)) */
-    const Number tau_2 = euler_step(U, t, tau_1);
+    tau_ratio_history_.push_back(tau_ratio_);
+    while (tau_ratio_history_.size() > tau_controller_history_)
+      tau_ratio_history_.pop_front();
 
-    AssertThrow(tau_2 * cfl_max_ / cfl_update_ >= tau_0,
-                ExcMessage("failed to recover from CFL violation"));
+    const Number prediction =
+        tau_controller_safety_ * *std::min_element(tau_ratio_history_.begin(),
+                                                   tau_ratio_history_.end());
+
+    tau_factor_ = std::min(
+        {Number(1.), prediction, tau_controller_growth_ * tau_factor_});
+
+#ifdef DEBUG_OUTPUT
+    std::cout << "        time-step scaling factor = " << tau_factor_
+              << std::endl;
+#endif
+  }
 
-    if (tau_2 * cfl_max_ / cfl_update_ < tau_1) {
-      /* Restart and force smaller time step: */
+
+  template <int dim, typename Number>
+  Number EulerModule<dim, Number>::ssph2_step(vector_type &U, Number t)
+  {
 #ifdef DEBUG_OUTPUT
-      std::cout << "        insufficient step size, restart" << std::endl;
+    std::cout << "EulerModule<dim, Number>::ssph2_step()" << std::endl;
 #endif
-      tau_0 = tau_2;
-      U.swap(temp_ssp_);
-      ++n_restarts_;
+
+    /*
+     * The old state U is left untouched until the very end. This way we
+     * can simply restart without having to keep a copy around.
+     */
+
+    Number tau_0 = Number(0.);
+    begin_step();
+
+  restart_ssph2_step:
+    /* Step 1: U1 = U_old + tau * L(U_old) */
+    Number tau_1 = euler_step(U, temp_ssp_, t, tau_0);
+    tau_1 = propose_tau(tau_1, tau_0);
+
+    /* Step 2: U2 = 1/2 U_old + 1/2 (U1 + tau L(U1)) */
+    const Number tau_2 = euler_step(temp_ssp_,
+                                    temp_ssp_,
+                                    t,
+                                    tau_1,
+                                    &U,
+                                    Number(1. / 2.),
+                                    Number(1. / 2.));
+
+    if (restart_required(tau_2, tau_1, tau_0))
       goto restart_ssph2_step;
-    }
 
-    U.sadd(Number(1. / 2.), Number(1. / 2.), temp_ssp_);
+    U.swap(temp_ssp_);
+    accept_step();
 
     return tau_1;
   }
@@ -1100,58 +2437,247 @@ namespace ryujin
     std::cout << "EulerModule<dim, Number>::ssprk3_step()" << std::endl;
 #endif
 
+    /*
+     * The old state U is left untouched until the very end. This way we
+     * can simply restart without having to keep a copy around.
+     */
+
     Number tau_0 = Number(0.);
+    begin_step();
 
   restart_ssprk3_step:
-    /* This also copies ghost elements: */
-    temp_ssp_ = U;
-
     /* Step 1: U1 = U_old + tau * L(U_old) */
-    Number tau_1 = euler_step(U, t, tau_0);
-
-    AssertThrow(tau_1 * cfl_max_ / cfl_update_ >= tau_0,
-                ExcMessage("failed to recover from CFL violation"));
-    tau_1 = (tau_0 == 0. ? tau_1 : tau_0);
+    Number tau_1 = euler_step(U, temp_ssp_, t, tau_0);
+    tau_1 = propose_tau(tau_1, tau_0);
 
     /* Step 2: U2 = 3/4 U_old + 1/4 (U1 + tau L(U1)) */
-    const Number tau_2 = euler_step(U, t, tau_1);
+    const Number tau_2 = euler_step(temp_ssp_,
+                                    temp_ssp_,
+                                    t,
+                                    tau_1,
+                                    &U,
+                                    Number(3. / 4.),
+                                    Number(1. / 4.));
+
+    if (restart_required(tau_2, tau_1, tau_0))
+      goto restart_ssprk3_step;
 
-    AssertThrow(tau_2 * cfl_max_ / cfl_update_ >= tau_0,
-                ExcMessage("failed to recover from CFL violation"));
+    /* Step 3: U_new = 1/3 U_old + 2/3 (U2 + tau L(U2)) */
+    const Number tau_3 = euler_step(temp_ssp_,
+                                    temp_ssp_,
+                                    t,
+                                    tau_1,
+                                    &U,
+                                    Number(1. / 3.),
+                                    Number(2. / 3.));
+
+    if (restart_required(tau_3, tau_1, tau_0))
+      goto restart_ssprk3_step;
 
-    if (tau_2 * cfl_max_ / cfl_update_ < tau_1) {
-      /* Restart and force smaller time step: */
+    U.swap(temp_ssp_);
+    accept_step();
+
+    return tau_1;
+  }
+
+
+  template <int dim, typename Number>
+  Number EulerModule<dim, Number>::ssprk43_step(vector_type &U, Number t)
+  {
 #ifdef DEBUG_OUTPUT
-      std::cout << "        insufficient step size, restart" << std::endl;
+    std::cout << "EulerModule<dim, Number>::ssprk43_step()" << std::endl;
 #endif
-      tau_0 = tau_2;
-      U.swap(temp_ssp_);
-      ++n_restarts_;
-      goto restart_ssprk3_step;
-    }
 
-    U.sadd(Number(1. / 4.), Number(3. / 4.), temp_ssp_);
+    /*
+     * Every stage is an explicit Euler step with step size h = tau / 2.
+     * The old state U is left untouched until the very end, all stages
+     * are computed in temp_ssp_.
+     */
 
-    /* Step 3: U_new = 1/3 U_old + 2/3 (U2 + tau L(U2)) */
-    const Number tau_3 = euler_step(U, t, tau_1);
+    Number tau_0 = Number(0.);
+    begin_step();
+
+  restart_ssprk43_step:
+    /* Step 1: U1 = U_old + h L(U_old) */
+    Number h = euler_step(U, temp_ssp_, t, tau_0);
+    h = propose_tau(h, tau_0);
+
+    /* Step 2: U2 = U1 + h L(U1) */
+    if (restart_required(euler_step(temp_ssp_, temp_ssp_, t, h), h, tau_0))
+      goto restart_ssprk43_step;
+
+    /* Step 3: U3 = 2/3 U_old + 1/3 (U2 + h L(U2)) */
+    if (restart_required(euler_step(temp_ssp_,
+                                    temp_ssp_,
+                                    t,
+                                    h,
+                                    &U,
+                                    Number(2. / 3.),
+                                    Number(1. / 3.)),
+                         h,
+                         tau_0))
+      goto restart_ssprk43_step;
+
+    /* Step 4: U_new = U3 + h L(U3) */
+    if (restart_required(euler_step(temp_ssp_, temp_ssp_, t, h), h, tau_0))
+      goto restart_ssprk43_step;
+
+    U.swap(temp_ssp_);
+    accept_step();
+
+    return Number(2.) * h;
+  }
 
-    AssertThrow(tau_3 * cfl_max_ / cfl_update_ >= tau_0,
-                ExcMessage("failed to recover from CFL violation"));
 
-    if (tau_3 * cfl_max_ < tau_1 * cfl_update_) {
-      /* Restart and force smaller time step: */
+  template <int dim, typename Number>
+  Number EulerModule<dim, Number>::ssprk53_step(vector_type &U, Number t)
+  {
 #ifdef DEBUG_OUTPUT
-      std::cout << "        insufficient step size, restart" << std::endl;
+    std::cout << "EulerModule<dim, Number>::ssprk53_step()" << std::endl;
 #endif
-      tau_0 = tau_3;
-      U.swap(temp_ssp_);
-      ++n_restarts_;
-      goto restart_ssprk3_step;
-    }
 
-    U.sadd(Number(2. / 3.), Number(1. / 3.), temp_ssp_);
+    Assert(temp_ssp_2_.size() == U.size(),
+           ExcMessage("temp_ssp_2_ is only allocated in prepare() if the "
+                      "corresponding TIME_STEP_ORDER is selected"));
 
-    return tau_1;
+    /*
+     * Shu-Osher coefficients of the optimal SSPRK(5,3) scheme. Every stage
+     * is a convex combination involving an explicit Euler step with step
+     * size h = beta * tau. The last stage refers back to U2 that we keep
+     * in temp_ssp_2_.
+     */
+
+    constexpr Number beta = 0.377268915331368;
+    constexpr Number alpha_30 = 0.355909775063327;
+    constexpr Number alpha_32 = 0.644090224936674;
+    constexpr Number alpha_40 = 0.367933791638137;
+    constexpr Number alpha_43 = 0.632066208361863;
+    constexpr Number alpha_52 = 0.237593836598569;
+    constexpr Number alpha_54 = 0.762406163401431;
+
+    Number tau_0 = Number(0.);
+    begin_step();
+
+  restart_ssprk53_step:
+    /* Step 1: U1 = U_old + h L(U_old) */
+    Number h = euler_step(U, temp_ssp_, t, tau_0);
+    h = propose_tau(h, tau_0);
+
+    /* Step 2: U2 = U1 + h L(U1) */
+    if (restart_required(euler_step(temp_ssp_, temp_ssp_2_, t, h), h, tau_0))
+      goto restart_ssprk53_step;
+
+    /* Step 3: U3 = alpha_30 U_old + alpha_32 (U2 + h L(U2)) */
+    if (restart_required(
+            euler_step(temp_ssp_2_, temp_ssp_, t, h, &U, alpha_30, alpha_32),
+            h,
+            tau_0))
+      goto restart_ssprk53_step;
+
+    /* Step 4: U4 = alpha_40 U_old + alpha_43 (U3 + h L(U3)) */
+    if (restart_required(
+            euler_step(temp_ssp_, temp_ssp_, t, h, &U, alpha_40, alpha_43),
+            h,
+            tau_0))
+      goto restart_ssprk53_step;
+
+    /* Step 5: U_new = alpha_52 U2 + alpha_54 (U4 + h L(U4)) */
+    if (restart_required(euler_step(temp_ssp_,
+                                    temp_ssp_,
+                                    t,
+                                    h,
+                                    &temp_ssp_2_,
+                                    alpha_52,
+                                    alpha_54),
+                         h,
+                         tau_0))
+      goto restart_ssprk53_step;
+
+    U.swap(temp_ssp_);
+    accept_step();
+
+    return h / beta;
+  }
+
+
+  template <int dim, typename Number>
+  Number EulerModule<dim, Number>::ssprk104_step(vector_type &U, Number t)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "EulerModule<dim, Number>::ssprk104_step()" << std::endl;
+#endif
+
+    Assert(temp_ssp_2_.size() == U.size(),
+           ExcMessage("temp_ssp_2_ is only allocated in prepare() if the "
+                      "corresponding TIME_STEP_ORDER is selected"));
+
+    /*
+     * Every stage is an explicit Euler step with step size h = tau / 6.
+     * We follow the two-register implementation of @cite Ketcheson2008
+     * with registers q1 = temp_ssp_ and q2 = temp_ssp_2_:
+     *
+     *   q1 = U_old;  q2 = U_old;
+     *   for i = 1..5:  q1 = q1 + h L(q1)
+     *   q2 = 1/25 q2 + 9/25 q1;  q1 = 15 q2 - 5 q1
+     *   for i = 6..9:  q1 = q1 + h L(q1)
+     *   U_new = q2 + 3/5 (q1 + h L(q1))
+     *
+     * In contrast to the original formulation we do not overwrite U_old
+     * (in order to be able to restart). The update of q1 after stage 5 is
+     * equal to 3/5 U_old + 2/5 q1 and fused into stage 5. q2 is then
+     * equal to 9/10 q1 - 1/2 U_old.
+     */
+
+    Number tau_0 = Number(0.);
+    begin_step();
+
+  restart_ssprk104_step:
+    /* Step 1: q1 = U_old + h L(U_old) */
+    Number h = euler_step(U, temp_ssp_, t, tau_0);
+    h = propose_tau(h, tau_0);
+
+    /* Steps 2 - 4: q1 = q1 + h L(q1) */
+    for (unsigned int s = 2; s <= 4; ++s)
+      if (restart_required(euler_step(temp_ssp_, temp_ssp_, t, h), h, tau_0))
+        goto restart_ssprk104_step;
+
+    /* Step 5: q1 = 3/5 U_old + 2/5 (q1 + h L(q1)) */
+    if (restart_required(euler_step(temp_ssp_,
+                                    temp_ssp_,
+                                    t,
+                                    h,
+                                    &U,
+                                    Number(3. / 5.),
+                                    Number(2. / 5.)),
+                         h,
+                         tau_0))
+      goto restart_ssprk104_step;
+
+    /* q2 = 9/10 q1 - 1/2 U_old (only locally owned entries are needed) */
+    temp_ssp_2_.equ(Number(9. / 10.), temp_ssp_);
+    temp_ssp_2_.add(Number(-1. / 2.), U);
+
+    /* Steps 6 - 9: q1 = q1 + h L(q1) */
+    for (unsigned int s = 6; s <= 9; ++s)
+      if (restart_required(euler_step(temp_ssp_, temp_ssp_, t, h), h, tau_0))
+        goto restart_ssprk104_step;
+
+    /* Step 10: U_new = q2 + 3/5 (q1 + h L(q1)) */
+    if (restart_required(euler_step(temp_ssp_,
+                                    temp_ssp_,
+                                    t,
+                                    h,
+                                    &temp_ssp_2_,
+                                    Number(1.),
+                                    Number(3. / 5.)),
+                         h,
+                         tau_0))
+      goto restart_ssprk104_step;
+
+    U.swap(temp_ssp_);
+    accept_step();
+
+    return Number(6.) * h;
   }
 
 
@@ -1169,6 +2695,12 @@ namespace ryujin
       return ssph2_step(U, t);
     case TimeStepOrder::third_order:
       return ssprk3_step(U, t);
+    case TimeStepOrder::third_order_four_stages:
+      return ssprk43_step(U, t);
+    case TimeStepOrder::third_order_five_stages:
+      return ssprk53_step(U, t);
+    case TimeStepOrder::fourth_order_ten_stages:
+      return ssprk104_step(U, t);
     }
 
     __builtin_unreachable();
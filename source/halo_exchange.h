@@ -0,0 +1,482 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 by the ryujin authors
+//
+
+#ifndef HALO_EXCHANGE_H
+#define HALO_EXCHANGE_H
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/partitioner.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A persistent, aggregated exchange of ghost values for a fixed set of
+   * vectors ("fields") that share a common scalar MPI partitioner. Every
+   * field is a dealii::LinearAlgebra::distributed::Vector<Number> (or a
+   * MultiComponentVector) storing n_components values per index in
+   * interleaved format with ghost values stored contiguously after the
+   * locally owned range.
+   *
+   * In contrast to calling update_ghost_values_start() and
+   * update_ghost_values_finish() on every vector individually, the values
+   * of all fields are packed into a single message per neighboring MPI
+   * rank. Buffers and MPI requests are set up once in reinit() with
+   * MPI_Send_init() and MPI_Recv_init() and are merely restarted with
+   * MPI_Startall() for every exchange. If compiled with
+   * USE_NEIGHBORHOOD_COLLECTIVES the exchange is instead performed with
+   * a single MPI-3 neighborhood collective (MPI_Ineighbor_alltoallv()) on
+   * a distributed graph communicator created in reinit().
+   *
+   * Intended use:
+   * ```
+   * halo_exchange.reinit(scalar_partitioner, {1, 1}, channel);
+   * // ...
+   * halo_exchange.start(alpha, second_variations);
+   * // work that does not access ghost values of alpha, second_variations
+   * halo_exchange.finish();
+   * ```
+   *
+   * Alternatively, the messages can be sent individually per receiving
+   * rank as soon as the corresponding values are available (see
+   * ChunkedSynchronizationDispatch):
+   * ```
+   * halo_exchange.start_receives(r);
+   * // compute r, and call for every import target p once all
+   * // import indices of p have been computed:
+   * halo_exchange.send(p);
+   * // ...
+   * halo_exchange.finish();
+   * ```
+   * This requires point-to-point communication, i.e., it is not
+   * available with USE_NEIGHBORHOOD_COLLECTIVES (see
+   * supports_individual_sends).
+   *
+   * Vectors passed to start() must not be reinitialized, and their ghost
+   * ranges must not be accessed, until finish() has returned. At most one
+   * exchange can be in flight per object.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <typename Number>
+  class HaloExchange
+  {
+  public:
+    HaloExchange();
+
+    HaloExchange(const HaloExchange &) = delete;
+    HaloExchange &operator=(const HaloExchange &) = delete;
+
+    ~HaloExchange();
+
+    /**
+     * Set up buffers and MPI requests for the exchange of fields with
+     * @p n_components components each (in the order in which they are
+     * later passed to start()). The MPI tag is derived from
+     * @p communication_channel and has to be different for all objects
+     * that might have exchanges in flight at the same time.
+     */
+    void reinit(const dealii::Utilities::MPI::Partitioner &scalar_partitioner,
+                const std::vector<unsigned int> &n_components,
+                const unsigned int communication_channel);
+
+    /**
+     * Pack the locally owned values of @p vectors that are ghosts on
+     * other MPI ranks and start the exchange.
+     */
+    template <typename... Vectors>
+    void start(Vectors &...vectors);
+
+    /**
+     * Whether messages can be sent individually with send().
+     */
+#if defined(DEAL_II_WITH_MPI) && defined(USE_NEIGHBORHOOD_COLLECTIVES)
+    static constexpr bool supports_individual_sends = false;
+#else
+    static constexpr bool supports_individual_sends = true;
+#endif
+
+    /**
+     * Start receiving ghost values of @p vectors without sending any
+     * messages. The exchange is completed by a call to send() for every
+     * import target followed by finish().
+     */
+    template <typename... Vectors>
+    void start_receives(Vectors &...vectors);
+
+    /**
+     * Pack the locally owned values of all vectors passed to
+     * start_receives() that are ghosts on the MPI rank associated with
+     * import target @p target and send them. This function may be called
+     * concurrently for different targets if MPI supports
+     * MPI_THREAD_MULTIPLE.
+     */
+    void send(const unsigned int target);
+
+    /**
+     * Wait for the exchange to complete and unpack all received values
+     * into the ghost ranges of the vectors passed to start().
+     */
+    void finish();
+
+    /**
+     * Return the number of messages sent per exchange.
+     */
+    unsigned int n_messages() const;
+
+  private:
+    void clear();
+
+    template <typename... Vectors>
+    void set_fields(Vectors &...vectors);
+
+    void pack(const unsigned int begin, const unsigned int end);
+
+    void unpack();
+
+    unsigned int n_owned_;
+    unsigned int n_values_;
+
+    std::vector<unsigned int> n_components_;
+    std::vector<Number *> fields_;
+
+    /* Locally owned indices to be sent, grouped by receiving rank: */
+    std::vector<unsigned int> import_indices_;
+
+    /*
+     * Pairs of MPI rank and end of the corresponding range of (import or
+     * ghost) indices:
+     */
+    std::vector<std::pair<unsigned int, unsigned int>> import_targets_;
+    std::vector<std::pair<unsigned int, unsigned int>> ghost_targets_;
+
+    dealii::AlignedVector<Number> send_buffer_;
+    dealii::AlignedVector<Number> receive_buffer_;
+
+#ifdef DEAL_II_WITH_MPI
+    std::vector<MPI_Request> requests_;
+
+#ifdef USE_NEIGHBORHOOD_COLLECTIVES
+    MPI_Comm graph_communicator_;
+    std::vector<int> send_counts_;
+    std::vector<int> send_displacements_;
+    std::vector<int> receive_counts_;
+    std::vector<int> receive_displacements_;
+#endif
+#endif
+  };
+
+
+  template <typename Number>
+  HaloExchange<Number>::HaloExchange()
+      : n_owned_(0)
+      , n_values_(0)
+#if defined(DEAL_II_WITH_MPI) && defined(USE_NEIGHBORHOOD_COLLECTIVES)
+      , graph_communicator_(MPI_COMM_NULL)
+#endif
+  {
+  }
+
+
+  template <typename Number>
+  HaloExchange<Number>::~HaloExchange()
+  {
+    clear();
+  }
+
+
+  template <typename Number>
+  void HaloExchange<Number>::clear()
+  {
+#ifdef DEAL_II_WITH_MPI
+    for (auto &request : requests_)
+      if (request != MPI_REQUEST_NULL)
+        MPI_Request_free(&request);
+    requests_.clear();
+
+#ifdef USE_NEIGHBORHOOD_COLLECTIVES
+    if (graph_communicator_ != MPI_COMM_NULL)
+      MPI_Comm_free(&graph_communicator_);
+    graph_communicator_ = MPI_COMM_NULL;
+#endif
+#endif
+  }
+
+
+  template <typename Number>
+  void HaloExchange<Number>::reinit(
+      const dealii::Utilities::MPI::Partitioner &scalar_partitioner,
+      const std::vector<unsigned int> &n_components,
+      const unsigned int communication_channel)
+  {
+    clear();
+
+    n_owned_ = scalar_partitioner.local_size();
+    n_components_ = n_components;
+    fields_.assign(n_components.size(), nullptr);
+
+    /* Number of values per index over all fields: */
+    n_values_ = std::accumulate(n_components.begin(), n_components.end(), 0u);
+    const unsigned int n_values = n_values_;
+
+    import_indices_.clear();
+    for (const auto &[begin, end] : scalar_partitioner.import_indices())
+      for (unsigned int i = begin; i < end; ++i)
+        import_indices_.push_back(i);
+
+    import_targets_.clear();
+    unsigned int n_imports = 0;
+    for (const auto &[rank, n] : scalar_partitioner.import_targets())
+      import_targets_.emplace_back(rank, n_imports += n);
+    Assert(n_imports == import_indices_.size(), dealii::ExcInternalError());
+
+    ghost_targets_.clear();
+    unsigned int n_ghosts = 0;
+    for (const auto &[rank, n] : scalar_partitioner.ghost_targets())
+      ghost_targets_.emplace_back(rank, n_ghosts += n);
+    Assert(n_ghosts == scalar_partitioner.n_ghost_indices(),
+           dealii::ExcInternalError());
+
+    send_buffer_.resize_fast(n_imports * n_values);
+    receive_buffer_.resize_fast(n_ghosts * n_values);
+
+#ifdef DEAL_II_WITH_MPI
+    const MPI_Comm mpi_communicator =
+        scalar_partitioner.get_mpi_communicator();
+
+    const unsigned int mpi_tag =
+        dealii::Utilities::MPI::internal::Tags::partitioner_export_start +
+        communication_channel;
+    Assert(mpi_tag <=
+               dealii::Utilities::MPI::internal::Tags::partitioner_export_end,
+           dealii::ExcInternalError());
+
+    /* Message sizes and offsets in units of Number: */
+    const auto range = [&](const auto &targets, const unsigned int p) {
+      const unsigned int begin = (p == 0 ? 0 : targets[p - 1].second);
+      return std::make_pair(begin * n_values,
+                            (targets[p].second - begin) * n_values);
+    };
+
+#ifdef USE_NEIGHBORHOOD_COLLECTIVES
+    std::vector<int> sources, destinations;
+    send_counts_.clear();
+    send_displacements_.clear();
+    receive_counts_.clear();
+    receive_displacements_.clear();
+
+    for (unsigned int p = 0; p < ghost_targets_.size(); ++p) {
+      const auto [offset, size] = range(ghost_targets_, p);
+      sources.push_back(ghost_targets_[p].first);
+      receive_displacements_.push_back(offset * sizeof(Number));
+      receive_counts_.push_back(size * sizeof(Number));
+    }
+
+    for (unsigned int p = 0; p < import_targets_.size(); ++p) {
+      const auto [offset, size] = range(import_targets_, p);
+      destinations.push_back(import_targets_[p].first);
+      send_displacements_.push_back(offset * sizeof(Number));
+      send_counts_.push_back(size * sizeof(Number));
+    }
+
+    int ierr = MPI_Dist_graph_create_adjacent(mpi_communicator,
+                                              sources.size(),
+                                              sources.data(),
+                                              MPI_UNWEIGHTED,
+                                              destinations.size(),
+                                              destinations.data(),
+                                              MPI_UNWEIGHTED,
+                                              MPI_INFO_NULL,
+                                              /* reorder */ 0,
+                                              &graph_communicator_);
+    AssertThrowMPI(ierr);
+    (void)mpi_tag;
+
+    requests_.assign(1, MPI_REQUEST_NULL);
+#else
+    requests_.assign(ghost_targets_.size() + import_targets_.size(),
+                     MPI_REQUEST_NULL);
+
+    for (unsigned int p = 0; p < ghost_targets_.size(); ++p) {
+      const auto [offset, size] = range(ghost_targets_, p);
+      const int ierr = MPI_Recv_init(receive_buffer_.data() + offset,
+                                     size * sizeof(Number),
+                                     MPI_BYTE,
+                                     ghost_targets_[p].first,
+                                     mpi_tag,
+                                     mpi_communicator,
+                                     &requests_[p]);
+      AssertThrowMPI(ierr);
+    }
+
+    for (unsigned int p = 0; p < import_targets_.size(); ++p) {
+      const auto [offset, size] = range(import_targets_, p);
+      const int ierr = MPI_Send_init(send_buffer_.data() + offset,
+                                     size * sizeof(Number),
+                                     MPI_BYTE,
+                                     import_targets_[p].first,
+                                     mpi_tag,
+                                     mpi_communicator,
+                                     &requests_[ghost_targets_.size() + p]);
+      AssertThrowMPI(ierr);
+    }
+#endif
+#else
+    (void)communication_channel;
+#endif
+  }
+
+
+  template <typename Number>
+  template <typename... Vectors>
+  void HaloExchange<Number>::set_fields(Vectors &...vectors)
+  {
+    Assert(sizeof...(Vectors) == n_components_.size(),
+           dealii::ExcMessage("Number of vectors does not match the number "
+                              "of fields set up in reinit()"));
+
+    fields_ = {vectors.begin()...};
+
+#ifdef DEBUG
+    const std::array<std::size_t, sizeof...(Vectors)> local_sizes{
+        {vectors.get_partitioner()->local_size()...}};
+    for (unsigned int f = 0; f < local_sizes.size(); ++f)
+      Assert(local_sizes[f] == n_owned_ * n_components_[f],
+             dealii::ExcMessage("Vector does not match the partitioner "
+                                "and number of components set up in "
+                                "reinit()"));
+#endif
+  }
+
+
+  template <typename Number>
+  template <typename... Vectors>
+  void HaloExchange<Number>::start(Vectors &...vectors)
+  {
+    set_fields(vectors...);
+
+    pack(0, import_indices_.size());
+
+#ifdef DEAL_II_WITH_MPI
+#ifdef USE_NEIGHBORHOOD_COLLECTIVES
+    const int ierr = MPI_Ineighbor_alltoallv(send_buffer_.data(),
+                                             send_counts_.data(),
+                                             send_displacements_.data(),
+                                             MPI_BYTE,
+                                             receive_buffer_.data(),
+                                             receive_counts_.data(),
+                                             receive_displacements_.data(),
+                                             MPI_BYTE,
+                                             graph_communicator_,
+                                             &requests_[0]);
+#else
+    const int ierr = MPI_Startall(requests_.size(), requests_.data());
+#endif
+    AssertThrowMPI(ierr);
+#endif
+  }
+
+
+  template <typename Number>
+  template <typename... Vectors>
+  void HaloExchange<Number>::start_receives(Vectors &...vectors)
+  {
+    AssertThrow(supports_individual_sends,
+                dealii::ExcMessage("Individual sends require point-to-point "
+                                   "communication"));
+
+    set_fields(vectors...);
+
+#ifdef DEAL_II_WITH_MPI
+    const int ierr = MPI_Startall(ghost_targets_.size(), requests_.data());
+    AssertThrowMPI(ierr);
+#endif
+  }
+
+
+  template <typename Number>
+  void HaloExchange<Number>::send(const unsigned int target)
+  {
+    AssertThrow(supports_individual_sends,
+                dealii::ExcMessage("Individual sends require point-to-point "
+                                   "communication"));
+    AssertIndexRange(target, import_targets_.size());
+
+    pack(target == 0 ? 0 : import_targets_[target - 1].second,
+         import_targets_[target].second);
+
+#ifdef DEAL_II_WITH_MPI
+    const int ierr = MPI_Start(&requests_[ghost_targets_.size() + target]);
+    AssertThrowMPI(ierr);
+#endif
+  }
+
+
+  template <typename Number>
+  void HaloExchange<Number>::finish()
+  {
+#ifdef DEAL_II_WITH_MPI
+    const int ierr =
+        MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
+#endif
+
+    unpack();
+  }
+
+
+  template <typename Number>
+  unsigned int HaloExchange<Number>::n_messages() const
+  {
+    return import_targets_.size();
+  }
+
+
+  template <typename Number>
+  void HaloExchange<Number>::pack(const unsigned int begin,
+                                  const unsigned int end)
+  {
+    Number *buffer = send_buffer_.data() + begin * n_values_;
+    for (unsigned int k = begin; k < end; ++k) {
+      const auto i = import_indices_[k];
+      for (unsigned int f = 0; f < fields_.size(); ++f) {
+        const unsigned int n_comp = n_components_[f];
+        buffer = std::copy(
+            fields_[f] + i * n_comp, fields_[f] + (i + 1) * n_comp, buffer);
+      }
+    }
+
+    Assert(buffer == send_buffer_.data() + end * n_values_,
+           dealii::ExcInternalError());
+    (void)buffer;
+  }
+
+
+  template <typename Number>
+  void HaloExchange<Number>::unpack()
+  {
+    const unsigned int n_ghosts =
+        ghost_targets_.empty() ? 0 : ghost_targets_.back().second;
+
+    const Number *buffer = receive_buffer_.data();
+    for (unsigned int k = 0; k < n_ghosts; ++k)
+      for (unsigned int f = 0; f < fields_.size(); ++f) {
+        const unsigned int n_comp = n_components_[f];
+        const auto i = n_owned_ + k;
+        std::copy(buffer, buffer + n_comp, fields_[f] + i * n_comp);
+        buffer += n_comp;
+      }
+  }
+
+} // namespace ryujin
+
+#endif /* HALO_EXCHANGE_H */
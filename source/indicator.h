@@ -90,6 +90,12 @@ namespace ryujin
      */
     using rank2_type = typename ProblemDescription<dim, Number>::rank2_type;
 
+    /**
+     * @copydoc ProblemDescription::precomputed_type
+     */
+    using precomputed_type =
+        typename ProblemDescription<dim, Number>::precomputed_type;
+
     /**
      * @copydoc ProblemDescription::ScalarNumber
      */
@@ -210,6 +216,15 @@ namespace ryujin
     void
     reset(const rank1_type &U_i, const Number entropy);
 
+    /**
+     * Variant of above function that takes the node-wise precomputed
+     * values (see ProblemDescription::precompute_values()) of U_i as
+     * additional argument.
+     */
+    void reset(const rank1_type &U_i,
+               const precomputed_type &precomputed_i,
+               const Number entropy);
+
     /**
      * When looping over the sparsity row, add the contribution associated
      * with the neighboring state U_j.
@@ -218,6 +233,17 @@ namespace ryujin
              const dealii::Tensor<1, dim, Number> &c_ij,
              const Number beta_ij,
              const Number entropy_j);
+
+    /**
+     * Variant of above function that takes the node-wise precomputed
+     * values (see ProblemDescription::precompute_values()) of U_j as
+     * additional argument.
+     */
+    void add(const rank1_type &U_j,
+             const precomputed_type &precomputed_j,
+             const dealii::Tensor<1, dim, Number> &c_ij,
+             const Number beta_ij,
+             const Number entropy_j);
     /**
      * Return the computed alpha_i value.
      */
@@ -231,6 +257,26 @@ namespace ryujin
     //@}
 
   private:
+    /**
+     * Implementation of reset() and add() taking the flux and inverse
+     * density of the state as arguments. Both are only used for the
+     * entropy-viscosity commutator.
+     */
+    //@{
+
+    void reset(const rank1_type &U_i,
+               const rank2_type &f,
+               const Number rho_inverse,
+               const Number entropy);
+
+    void add(const rank1_type &U_j,
+             const rank2_type &f_j,
+             const Number rho_j_inverse,
+             const dealii::Tensor<1, dim, Number> &c_ij,
+             const Number beta_ij,
+             const Number entropy_j);
+
+    //@}
     /**
      * @name
      */
@@ -286,12 +332,40 @@ namespace ryujin
   template <int dim, typename Number>
   DEAL_II_ALWAYS_INLINE inline void Indicator<dim, Number>::reset(
       const rank1_type &U_i, const Number entropy)
+  {
+    if constexpr (indicator_ == Indicators::entropy_viscosity_commutator)
+      reset(U_i,
+            ProblemDescription<dim, Number>::f(U_i),
+            Number(1.) / U_i[0],
+            entropy);
+    else
+      reset(U_i, rank2_type(), Number(0.), entropy);
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline void
+  Indicator<dim, Number>::reset(const rank1_type &U_i,
+                                const precomputed_type &precomputed_i,
+                                const Number entropy)
+  {
+    using PD = ProblemDescription<dim, Number>;
+    reset(U_i, PD::f(precomputed_i), PD::rho_inverse(precomputed_i), entropy);
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline void
+  Indicator<dim, Number>::reset(const rank1_type &U_i,
+                                const rank2_type &f,
+                                const Number rho_inverse,
+                                const Number entropy)
   {
     if constexpr (indicator_ == Indicators::entropy_viscosity_commutator) {
       rho_i = U_i[0];
-      rho_i_inverse = Number(1.) / rho_i;
+      rho_i_inverse = rho_inverse;
       eta_i = entropy;
-      f_i = ProblemDescription<dim, Number>::f(U_i);
+      f_i = f;
 
       d_eta_i =
           evc_entropy_ == Entropy::mathematical
@@ -326,12 +400,48 @@ namespace ryujin
                               const dealii::Tensor<1, dim, Number> &c_ij,
                               const Number beta_ij,
                               const Number entropy_j)
+  {
+    if constexpr (indicator_ == Indicators::entropy_viscosity_commutator)
+      add(U_j,
+          ProblemDescription<dim, Number>::f(U_j),
+          Number(1.) / U_j[0],
+          c_ij,
+          beta_ij,
+          entropy_j);
+    else
+      add(U_j, rank2_type(), Number(0.), c_ij, beta_ij, entropy_j);
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline void
+  Indicator<dim, Number>::add(const rank1_type &U_j,
+                              const precomputed_type &precomputed_j,
+                              const dealii::Tensor<1, dim, Number> &c_ij,
+                              const Number beta_ij,
+                              const Number entropy_j)
+  {
+    using PD = ProblemDescription<dim, Number>;
+    add(U_j,
+        PD::f(precomputed_j),
+        PD::rho_inverse(precomputed_j),
+        c_ij,
+        beta_ij,
+        entropy_j);
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline void
+  Indicator<dim, Number>::add(const rank1_type &U_j,
+                              const rank2_type &f_j,
+                              const Number rho_j_inverse,
+                              const dealii::Tensor<1, dim, Number> &c_ij,
+                              const Number beta_ij,
+                              const Number entropy_j)
   {
     if constexpr (indicator_ == Indicators::entropy_viscosity_commutator) {
-      const auto &rho_j = U_j[0];
-      const auto rho_j_inverse = Number(1.) / rho_j;
       const auto m_j = ProblemDescription<dim, Number>::momentum(U_j);
-      const auto f_j = ProblemDescription<dim, Number>::f(U_j);
       const auto eta_j = entropy_j;
 
       left += (eta_j * rho_j_inverse - eta_i * rho_i_inverse) * (m_j * c_ij);
@@ -180,6 +180,19 @@ namespace ryujin
      */
     void apply_relaxation(const Number hd_i);
 
+    /**
+     * Return the relaxation radius
+     * \f$r_i = 2\,(h_i^d)^{\texttt{relaxation_order}/4}\f$ used in
+     * apply_relaxation(). The radius only depends on the mesh and can
+     * thus be precomputed.
+     */
+    static Number relaxation_radius(const Number hd_i);
+
+    /**
+     * Apply relaxation with a precomputed relaxation_radius().
+     */
+    void apply_relaxation_with_radius(const Number r_i);
+
     /**
      * Return the computed bounds.
      */
@@ -297,6 +310,29 @@ namespace ryujin
   template <int dim, typename Number>
   DEAL_II_ALWAYS_INLINE inline void
   Limiter<dim, Number>::apply_relaxation(Number hd_i)
+  {
+    if constexpr (!relax_bounds_)
+      return;
+
+    if constexpr (limiter_ == Limiters::none)
+      return;
+
+    apply_relaxation_with_radius(relaxation_radius(hd_i));
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline Number
+  Limiter<dim, Number>::relaxation_radius(Number hd_i)
+  {
+    return Number(2.) * dealii::Utilities::fixed_power<relaxation_order_>(
+                            std::sqrt(std::sqrt(hd_i)));
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline void
+  Limiter<dim, Number>::apply_relaxation_with_radius(Number r_i)
   {
     if constexpr (!relax_bounds_)
       return;
@@ -306,10 +342,6 @@ namespace ryujin
     if constexpr (limiter_ == Limiters::none)
       return;
 
-    const Number r_i =
-        Number(2.) * dealii::Utilities::fixed_power<relaxation_order_>(
-                         std::sqrt(std::sqrt(hd_i)));
-
     constexpr ScalarNumber eps = std::numeric_limits<ScalarNumber>::epsilon();
     const Number rho_relaxation =
         std::abs(rho_relaxation_numerator) /
@@ -6,11 +6,22 @@
 #ifndef LOCAL_INDEX_HANDLING_H
 #define LOCAL_INDEX_HANDLING_H
 
+#include <deal.II/base/geometry_info.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/mapping.h>
 #include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <tuple>
 
 namespace ryujin
 {
@@ -87,6 +98,144 @@ namespace ryujin
      */
     using dealii::DoFRenumbering::Cuthill_McKee;
 
+    /**
+     * Reorder all locally owned degrees of freedom along a space filling
+     * curve through their support points: the Hilbert curve if @p
+     * hilbert is set to true, otherwise the Morton (Z order) curve. The
+     * curve is laid out in the bounding box of the locally owned support
+     * points.
+     *
+     * Contrary to Cuthill McKee, which only sees the graph of the
+     * sparsity pattern, this ordering keeps spatially close degrees of
+     * freedom close in index space. The subsequent renumberings
+     * export_indices_first() and internal_range() preserve the relative
+     * order of indices within the ranges (and buckets) they create. Thus,
+     * the lanes of a SIMD row group are neighbors on the curve and the
+     * column indices gathered for the lanes of a group tend to fall onto
+     * shared cache lines.
+     *
+     * @ingroup FiniteElement
+     */
+    template <int dim>
+    void space_filling_curve(dealii::DoFHandler<dim> &dof_handler,
+                             const dealii::Mapping<dim> &mapping,
+                             const bool hilbert = true)
+    {
+      using namespace dealii;
+
+      const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+      const auto n_locally_owned = locally_owned.n_elements();
+
+      /* The locally owned index range has to be contiguous */
+      Assert(locally_owned.is_contiguous() == true,
+             dealii::ExcMessage(
+                 "Need a contiguous set of locally owned indices."));
+
+      /* Offset to translate from global to local index range */
+      const auto offset = n_locally_owned != 0 ? *locally_owned.begin() : 0;
+
+      std::map<types::global_dof_index, Point<dim>> support_points;
+      dealii::DoFTools::map_dofs_to_support_points(
+          mapping, dof_handler, support_points);
+
+      /* Determine the bounding box of all locally owned support points: */
+
+      std::vector<Point<dim>> points(n_locally_owned);
+      Point<dim> lower;
+      Point<dim> upper;
+      for (unsigned int d = 0; d < dim; ++d) {
+        lower[d] = std::numeric_limits<double>::max();
+        upper[d] = std::numeric_limits<double>::lowest();
+      }
+
+      for (const auto &[index, point] : support_points) {
+        if (!locally_owned.is_element(index))
+          continue;
+        points[index - offset] = point;
+        for (unsigned int d = 0; d < dim; ++d) {
+          lower[d] = std::min(lower[d], point[d]);
+          upper[d] = std::max(upper[d], point[d]);
+        }
+      }
+
+      /*
+       * Compute integer coordinates with bits_per_dim bits in every
+       * direction and the (interleaved) index along the curve. The
+       * Hilbert index is computed with Skilling's algorithm ("Programming
+       * the Hilbert curve", AIP Conf. Proc. 707, 2004) that transforms
+       * the coordinates in place such that interleaving their bits yields
+       * the Hilbert index:
+       */
+
+      constexpr unsigned int bits_per_dim = dim == 1 ? 32 : 64 / dim;
+      constexpr std::uint64_t max_coordinate =
+          (std::uint64_t(1) << bits_per_dim) - 1;
+
+      const auto curve_index = [&](const Point<dim> &point) {
+        std::array<std::uint64_t, dim> X;
+        for (unsigned int d = 0; d < dim; ++d) {
+          const double extent = upper[d] - lower[d];
+          const double relative =
+              extent > 0. ? (point[d] - lower[d]) / extent : 0.;
+          X[d] = static_cast<std::uint64_t>(relative * max_coordinate);
+        }
+
+        /* In 1D both curves coincide: */
+        if (hilbert && dim > 1) {
+          const std::uint64_t M = std::uint64_t(1) << (bits_per_dim - 1);
+
+          /* Inverse undo: */
+          for (std::uint64_t Q = M; Q > 1; Q >>= 1) {
+            const std::uint64_t P = Q - 1;
+            for (unsigned int d = 0; d < dim; ++d) {
+              if (X[d] & Q) {
+                X[0] ^= P;
+              } else {
+                const std::uint64_t t = (X[0] ^ X[d]) & P;
+                X[0] ^= t;
+                X[d] ^= t;
+              }
+            }
+          }
+
+          /* Gray encode: */
+          for (unsigned int d = 1; d < dim; ++d)
+            X[d] ^= X[d - 1];
+          std::uint64_t t = 0;
+          for (std::uint64_t Q = M; Q > 1; Q >>= 1)
+            if (X[dim - 1] & Q)
+              t ^= Q - 1;
+          for (unsigned int d = 0; d < dim; ++d)
+            X[d] ^= t;
+        }
+
+        /* Interleave bits, most significant first: */
+        std::uint64_t result = 0;
+        for (int b = bits_per_dim - 1; b >= 0; --b)
+          for (unsigned int d = 0; d < dim; ++d)
+            result = (result << 1) | ((X[d] >> b) & 1);
+        return result;
+      };
+
+      std::vector<std::uint64_t> keys(n_locally_owned);
+      for (unsigned int i = 0; i < n_locally_owned; ++i)
+        keys[i] = curve_index(points[i]);
+
+      std::vector<unsigned int> permutation(n_locally_owned);
+      std::iota(permutation.begin(), permutation.end(), 0);
+      std::stable_sort(permutation.begin(),
+                       permutation.end(),
+                       [&](const auto a, const auto b) {
+                         return keys[a] < keys[b];
+                       });
+
+      std::vector<dealii::types::global_dof_index> new_order(n_locally_owned);
+      for (unsigned int k = 0; k < n_locally_owned; ++k)
+        new_order[permutation[k]] = offset + k;
+
+      dof_handler.renumber_dofs(new_order);
+    }
+
     /**
      * Reorder all export indices in the locally owned index range to the
      * start of the index range.
@@ -157,17 +306,35 @@ namespace ryujin
      * all locally owned degrees of freedom to ensure that a local index
      * range \f$[0, \text{n_locally_internal_}) \subset [0,
      * \text{n_locally_owned})\f$ is available that
-     *  - contains no boundary dof
-     *  - contains no foreign degree of freedom
-     *  - has "standard" connectivity, i.e. 2, 8, or 26 neighboring DoFs
-     *    (in 1, 2, 3D).
+     *  - contains no constrained degree of freedom
+     *  - consists of consecutive groups of @p group_size indices, where
+     *    all rows of a group have the same row length and either all or
+     *    none of the degrees of freedom of a group are situated at the
+     *    boundary.
+     *
+     * The row length is determined from a sparsity pattern created with
+     * @p affine_constraints (in global numbering). Rows of equal length
+     * and boundary status are collected in buckets preserving their
+     * previous order; every bucket contributes as many full groups as
+     * possible. The few remaining indices of every bucket are moved to the
+     * non-vectorized range \f$[\text{n_locally_internal_},
+     * \text{n_locally_owned})\f$.
+     *
+     * If @p n_export_indices is nonzero, the indices in \f$[0,
+     * \text{n_export_indices})\f$ are assumed to be export indices (see
+     * export_indices_first()) and are bucketed separately and placed
+     * first.
      *
      * Returns the right boundary n_internal of the internal index range.
      *
      * @ingroup FiniteElement
      */
-    template <int dim>
-    unsigned int internal_range(dealii::DoFHandler<dim> &dof_handler)
+    template <int dim, typename Number>
+    unsigned int
+    internal_range(dealii::DoFHandler<dim> &dof_handler,
+                   const dealii::AffineConstraints<Number> &affine_constraints,
+                   const unsigned int group_size,
+                   const unsigned int n_export_indices = 0)
     {
       const auto &locally_owned = dof_handler.locally_owned_dofs();
       const auto n_locally_owned = locally_owned.n_elements();
@@ -186,50 +353,75 @@ namespace ryujin
           dofs_per_cell);
 
       /*
-       * First pass: Accumulate how many cells are associated with a
-       * given degree of freedom and mark all degrees of freedom shared
-       * with a different number of cells than 2, 4, or 8 with
-       * numbers::invalid_dof_index:
+       * First pass: Determine the row length of all locally owned rows
+       * (exactly as done later in make_local_sparsity_pattern() for the
+       * locally owned and ghost cells) and mark all degrees of freedom
+       * situated at the boundary:
        */
 
-      std::vector<dealii::types::global_dof_index> new_order(n_locally_owned);
+      dealii::DynamicSparsityPattern dsp(
+          dof_handler.n_dofs(), dof_handler.n_dofs(), locally_owned);
+
+      std::vector<bool> at_boundary(n_locally_owned, false);
 
       for (auto cell : dof_handler.active_cell_iterators()) {
         if (cell->is_artificial())
           continue;
 
         cell->get_dof_indices(local_dof_indices);
+        affine_constraints.add_entries_local_to_global(
+            local_dof_indices, dsp, false);
 
-        for (unsigned int j = 0; j < dofs_per_cell; ++j) {
-          const auto &index = local_dof_indices[j];
-          if (!locally_owned.is_element(index))
+        for (auto f : dealii::GeometryInfo<dim>::face_indices()) {
+          if (!cell->face(f)->at_boundary())
             continue;
 
-          Assert(index - offset < n_locally_owned, dealii::ExcInternalError());
-          new_order[index - offset] += 1;
+          for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+            const auto &index = local_dof_indices[j];
+            if (!locally_owned.is_element(index) ||
+                !dof_handler.get_fe().has_support_on_face(j, f))
+              continue;
+
+            Assert(index - offset < n_locally_owned,
+                   dealii::ExcInternalError());
+            at_boundary[index - offset] = true;
+          }
         }
       }
 
-      constexpr dealii::types::global_dof_index standard_number_of_neighbors =
-          dim == 1 ? 2 : (dim == 2 ? 4 : 8);
+      /*
+       * Second pass: Sort all unconstrained degrees of freedom into
+       * buckets of (export status, row length, boundary status):
+       */
+
+      using key_type = std::tuple<bool, unsigned int, bool>;
+      std::map<key_type, std::vector<unsigned int>> buckets;
+
+      for (unsigned int i = 0; i < n_locally_owned; ++i) {
+        const unsigned int row_length = dsp.row_length(offset + i);
 
-      for (auto &it : new_order) {
-        if (it == standard_number_of_neighbors)
-          it = 0;
-        else
-          it = dealii::numbers::invalid_dof_index;
+        /* Skip constrained degrees of freedom */
+        if (row_length <= 1)
+          continue;
+
+        buckets[{i >= n_export_indices, row_length, at_boundary[i]}]
+            .push_back(i);
       }
 
-      /* Second pass: Create renumbering. */
+      /* Third pass: Create renumbering. */
+
+      std::vector<dealii::types::global_dof_index> new_order(
+          n_locally_owned, dealii::numbers::invalid_dof_index);
 
       dealii::types::global_dof_index index = offset;
 
-      unsigned int n_locally_internal = 0;
-      for (auto &it : new_order)
-        if (it != dealii::numbers::invalid_dof_index) {
-          it = index++;
-          n_locally_internal++;
-        }
+      for (const auto &[key, bucket] : buckets) {
+        const unsigned int n_groups = bucket.size() / group_size;
+        for (unsigned int k = 0; k < n_groups * group_size; ++k)
+          new_order[bucket[k]] = index++;
+      }
+
+      const unsigned int n_locally_internal = index - offset;
 
       for (auto &it : new_order)
         if (it == dealii::numbers::invalid_dof_index)
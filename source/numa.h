@@ -0,0 +1,220 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 by the ryujin authors
+//
+
+#ifndef NUMA_H
+#define NUMA_H
+
+#include "openmp.h"
+
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/vectorization.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ryujin
+{
+  /**
+   * @name NUMA aware memory placement
+   *
+   * On Linux a memory page is placed on the NUMA node of the thread that
+   * touches it first. All our compute loops distribute the row ranges
+   * [0, n_internal) (in steps of simd_length) and [n_internal, n_owned)
+   * statically over all threads (see RYUJIN_OMP_FOR). Initializing
+   * storage with exactly the same loops thus places every page on the
+   * node of the thread that later works on it.
+   *
+   * This requires that threads are bound to cores (OMP_PROC_BIND,
+   * OMP_PLACES). Otherwise the operating system is free to migrate
+   * threads after the first touch.
+   */
+  //@{
+
+  /**
+   * Reinitialize @p vector with the MPI partitioner @p partitioner
+   * without touching the memory on the calling thread and zero it out in
+   * parallel with the same row distribution as the compute loops. The
+   * locally owned range consists of @p n_owned rows of which the first
+   * @p n_internal rows are grouped into SIMD row groups.
+   *
+   * @note The placement is only determined when memory is freshly
+   * allocated. Reinitializing a vector that already holds storage of the
+   * same size keeps the existing pages.
+   */
+  template <typename Number,
+            int simd_length = dealii::VectorizedArray<Number>::size()>
+  void reinit_first_touch(
+      dealii::LinearAlgebra::distributed::Vector<Number> &vector,
+      const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+          &partitioner,
+      const unsigned int n_internal,
+      const unsigned int n_owned)
+  {
+    {
+      /*
+       * Reinitializing from a prototype with omit_zeroing_entries set
+       * allocates memory without writing to it:
+       */
+      dealii::LinearAlgebra::distributed::Vector<Number> prototype;
+      prototype.reinit(partitioner);
+      vector.reinit(prototype, /*omit_zeroing_entries*/ true);
+    }
+
+    if (n_owned == 0)
+      return;
+
+    const unsigned int n_components = partitioner->local_size() / n_owned;
+    Assert(n_components * n_owned == partitioner->local_size(),
+           dealii::ExcMessage("Partitioner does not match row count"));
+    Assert(n_internal % simd_length == 0, dealii::ExcInternalError());
+
+    const unsigned int n_relevant =
+        (partitioner->local_size() + partitioner->n_ghost_indices()) /
+        n_components;
+
+    /* Ghost values are stored contiguously after the locally owned range: */
+    Number *data = vector.begin();
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = 0; i < n_internal; i += simd_length)
+      std::fill(data + i * n_components,
+                data + (i + simd_length) * n_components,
+                Number(0.));
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = n_internal; i < n_owned; ++i)
+      std::fill(data + i * n_components,
+                data + (i + 1) * n_components,
+                Number(0.));
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = n_owned; i < n_relevant; ++i)
+      std::fill(data + i * n_components,
+                data + (i + 1) * n_components,
+                Number(0.));
+
+    RYUJIN_PARALLEL_REGION_END
+  }
+
+
+  /**
+   * Return the number of memory pages of the memory region
+   * [@p pointer, @p pointer + @p size) (size in bytes) that reside on
+   * NUMA node k in entry k of the returned vector. Pages that have not
+   * been touched yet are not counted. An empty vector is returned if the
+   * information is not available (non-Linux systems, or kernels without
+   * NUMA support).
+   */
+  inline std::vector<std::size_t> page_placement(const void *pointer,
+                                                 const std::size_t size)
+  {
+    std::vector<std::size_t> result;
+
+#if defined(__linux__) && defined(SYS_move_pages)
+    if (pointer == nullptr || size == 0)
+      return result;
+
+    const std::uintptr_t page_size = sysconf(_SC_PAGESIZE);
+    const auto begin = reinterpret_cast<std::uintptr_t>(pointer);
+    const auto end = begin + size;
+
+    std::vector<void *> pages;
+    for (auto p = begin / page_size * page_size; p < end; p += page_size)
+      pages.push_back(reinterpret_cast<void *>(p));
+
+    /*
+     * Calling move_pages() with a null pointer for the target nodes only
+     * queries the current location of every page:
+     */
+    std::vector<int> status(pages.size());
+    const long ierr = syscall(SYS_move_pages,
+                              0,
+                              pages.size(),
+                              pages.data(),
+                              nullptr,
+                              status.data(),
+                              0);
+    if (ierr != 0)
+      return result;
+
+    for (const auto node : status) {
+      /* Negative values are error codes, e.g. -ENOENT for missing pages: */
+      if (node < 0)
+        continue;
+      if (static_cast<std::size_t>(node) >= result.size())
+        result.resize(node + 1);
+      ++result[node];
+    }
+#else
+    (void)pointer;
+    (void)size;
+#endif
+
+    return result;
+  }
+
+
+  /**
+   * Return for every OpenMP thread the pair (cpu, NUMA node) it is
+   * currently running on. Entries are set to -1 if the information is
+   * not available.
+   */
+  inline std::vector<std::pair<int, int>> thread_placement()
+  {
+    std::vector<std::pair<int, int>> result(omp_get_max_threads(), {-1, -1});
+
+#if defined(__linux__) && defined(SYS_getcpu)
+    RYUJIN_PARALLEL_REGION_BEGIN
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+      result[omp_get_thread_num()] = {int(cpu), int(node)};
+    RYUJIN_PARALLEL_REGION_END
+#endif
+
+    return result;
+  }
+
+
+  /**
+   * Return the OpenMP thread binding policy as a string. The binding
+   * policy is fixed at program start through the environment variables
+   * OMP_PROC_BIND and OMP_PLACES and cannot be changed afterwards. A
+   * return value of "false" indicates that threads are not bound.
+   */
+  inline std::string thread_binding()
+  {
+    switch (omp_get_proc_bind()) {
+    case omp_proc_bind_false:
+      return "false";
+    case omp_proc_bind_true:
+      return "true";
+    case omp_proc_bind_master:
+      return "master";
+    case omp_proc_bind_close:
+      return "close";
+    case omp_proc_bind_spread:
+      return "spread";
+    default:
+      return "unknown";
+    }
+  }
+
+  //@}
+
+} // namespace ryujin
+
+#endif /* NUMA_H */
@@ -8,8 +8,10 @@
 
 #include <compile_time_options.h>
 
+#include "boundary_table.h"
 #include "convenience_macros.h"
 #include "discretization.h"
+#include "edge_list_simd.h"
 #include "multicomponent_vector.h"
 #include "sparse_matrix_simd.h"
 
@@ -69,6 +71,27 @@ namespace ryujin
      */
     using vector_type = MultiComponentVector<Number, problem_dimension>;
 
+    /**
+     * Number type used for storing the mass matrix, the beta_ij, and the
+     * c_ij matrices. All arithmetic is performed with Number.
+     */
+#ifdef USE_MIXED_PRECISION_OFFLINE
+    using storage_type = float;
+#else
+    using storage_type = Number;
+#endif
+
+    /**
+     * Shorthand typedef for a SparseMatrixSIMD storing a (static)
+     * precomputed matrix with n_components components.
+     */
+    template <int n_components>
+    using matrix_type =
+        SparseMatrixSIMD<Number,
+                         n_components,
+                         dealii::VectorizedArray<Number>::size(),
+                         storage_type>;
+
     /**
      * Constructor
      */
@@ -120,17 +143,30 @@ namespace ryujin
                         dealii::Point<dim>>>
         boundary_map_;
 
+    BoundaryTable<dim, Number> boundary_table_;
+
+    std::vector<bool> boundary_row_groups_;
+
     SparsityPatternSIMD<dealii::VectorizedArray<Number>::size()>
         sparsity_pattern_simd_;
 
-    SparseMatrixSIMD<Number> mass_matrix_;
+    matrix_type<1> mass_matrix_;
 
     dealii::LinearAlgebra::distributed::Vector<Number> lumped_mass_matrix_;
     dealii::LinearAlgebra::distributed::Vector<Number>
         lumped_mass_matrix_inverse_;
 
-    SparseMatrixSIMD<Number> betaij_matrix_;
-    SparseMatrixSIMD<Number, dim> cij_matrix_;
+    matrix_type<1> betaij_matrix_;
+    matrix_type<dim> cij_matrix_;
+
+#ifdef USE_PRECOMPUTED_NORMALS
+    matrix_type<1> cij_norm_matrix_;
+    matrix_type<dim> nij_matrix_;
+#endif
+
+#ifdef USE_EDGE_DIJ
+    EdgeListSIMD<Number, dim> edge_list_;
+#endif
 
     Number measure_of_omega_;
 
@@ -178,8 +214,9 @@ namespace ryujin
     /**
      * Number of locally owned internal degrees of freedom: In (MPI rank)
      * local numbering all indices in the half open interval [0,
-     * n_locally_internal_) are owned by this processor, have standard
-     * connectivity, and are not situated at a boundary.
+     * n_locally_internal_) are owned by this processor, are not
+     * constrained, and are grouped into SIMD row groups of equal row
+     * length (see DoFRenumbering::internal_range()).
      */
     ACCESSOR_READ_ONLY(n_locally_internal)
 
@@ -211,6 +248,22 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(boundary_map)
 
+    /**
+     * A flat, indexed copy of the boundary map (bitmap of boundary
+     * indices, and packed normals, boundary ids, and positions) used in
+     * the hot loops of EulerModule::euler_step() and Postprocessor. Local
+     * numbering.
+     */
+    ACCESSOR_READ_ONLY(boundary_table)
+
+    /**
+     * For every SIMD row group \f$[i, i + \texttt{simd_length})\f$ of the
+     * vectorized index range \f$[0,\texttt{n_locally_internal()})\f$
+     * record whether the group consists of boundary degrees of freedom.
+     * Indexed by \f$i / \texttt{simd_length}\f$.
+     */
+    ACCESSOR_READ_ONLY(boundary_row_groups)
+
     /**
      * A sparsity pattern for matrices in vectorized format. Local
      * numbering.
@@ -244,6 +297,29 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(cij_matrix)
 
+#ifdef USE_PRECOMPUTED_NORMALS
+    /**
+     * The norms \f$|c_{ij}|\f$ of the \f$(c_{ij})\f$ matrix. (SIMD
+     * storage, local numbering)
+     */
+    ACCESSOR_READ_ONLY(cij_norm_matrix)
+
+    /**
+     * The unit normals \f$n_{ij} = c_{ij} / |c_{ij}|\f$. Set to zero for
+     * vanishing \f$c_{ij}\f$. (SIMD storage, local numbering)
+     */
+    ACCESSOR_READ_ONLY(nij_matrix)
+#endif
+
+#ifdef USE_EDGE_DIJ
+    /**
+     * A list of all unique edges \f$(i,j)\f$, \f$i<j\f$, with locally
+     * owned row index along with the norms and unit normals of the
+     * \f$c_{ij}\f$ coefficients. (SIMD storage, local numbering)
+     */
+    ACCESSOR_READ_ONLY(edge_list)
+#endif
+
     /**
      * Size of computational domain.
      */
@@ -255,11 +331,26 @@ namespace ryujin
     ACCESSOR_READ_ONLY(discretization)
 
   private:
+    /**
+     * @name Run time options
+     */
+    //@{
+
+    std::string dof_renumbering_;
+
+    //@}
+    /**
+     * @name Internal data:
+     */
+    //@{
+
     /* Scratch storage: */
     dealii::SparsityPattern sparsity_pattern_assembly_;
     dealii::AffineConstraints<Number> affine_constraints_assembly_;
 
     const MPI_Comm &mpi_communicator_;
+
+    //@}
   };
 
 } /* namespace ryujin */
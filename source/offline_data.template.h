@@ -8,6 +8,7 @@
 
 #include "local_index_handling.h"
 #include "multicomponent_vector.h"
+#include "numa.h"
 #include "offline_data.h"
 #include "problem_description.h"
 #include "scratch_data.h"
@@ -40,6 +41,13 @@ namespace ryujin
       , discretization_(&discretization)
       , mpi_communicator_(mpi_communicator)
   {
+    dof_renumbering_ = "hilbert";
+    add_parameter("dof renumbering",
+                  dof_renumbering_,
+                  "Locality optimizing renumbering of the locally owned "
+                  "degrees of freedom that is applied prior to the "
+                  "export and SIMD renumbering. Valid choices are "
+                  "\"cuthill mckee\", \"hilbert\", and \"morton\"");
   }
 
 
@@ -55,22 +63,82 @@ namespace ryujin
     dof_handler_.initialize(discretization_->triangulation(),
                             discretization_->finite_element());
 
-    // FIXME: Cuthill McKee isn't particularly useful...
-    DoFRenumbering::Cuthill_McKee(dof_handler_);
+    if (dof_renumbering_ == "cuthill mckee") {
+      DoFRenumbering::Cuthill_McKee(dof_handler_);
+    } else if (dof_renumbering_ == "hilbert") {
+      DoFRenumbering::space_filling_curve(
+          dof_handler_, discretization_->mapping(), /*hilbert*/ true);
+    } else if (dof_renumbering_ == "morton") {
+      DoFRenumbering::space_filling_curve(
+          dof_handler_, discretization_->mapping(), /*hilbert*/ false);
+    } else {
+      AssertThrow(false, dealii::ExcMessage("Unknown dof renumbering."));
+    }
 
 #ifdef USE_COMMUNICATION_HIDING
-#ifdef DEBUG
     const unsigned int n_export_indices_preliminary =
-#endif
         DoFRenumbering::export_indices_first(dof_handler_, mpi_communicator_);
+    (void)n_export_indices_preliminary;
 #endif
 
+    /*
+     * Set up hanging node and periodicity constraints on the locally
+     * relevant index range in the current (global) numbering:
+     */
+    const auto make_constraints = [&](AffineConstraints<Number> &constraints) {
+      IndexSet locally_relevant;
+      DoFTools::extract_locally_relevant_dofs(dof_handler_, locally_relevant);
+      constraints.reinit(locally_relevant);
+
+      const auto n_periodic_faces =
+          discretization_->triangulation().get_periodic_face_map().size();
+      if (n_periodic_faces != 0) {
+        /*
+         * Enforce periodic boundary conditions. We assume that the mesh is
+         * in "normal configuration". By convention we also omit enforcing
+         * periodicity in x direction. This avoids accidentally glueing the
+         * corner degrees of freedom together which leads to instability.
+         */
+        if constexpr (dim != 1 && std::is_same<Number, double>::value) {
+          for (int i = 1; i < dim; ++i) /* omit x direction! */
+            DoFTools::make_periodicity_constraints(dof_handler_,
+                                                   /*b_id */ Boundary::periodic,
+                                                   /*direction*/ i,
+                                                   constraints);
+        } else {
+          AssertThrow(false, dealii::ExcNotImplemented());
+        }
+      }
+
+      DoFTools::make_hanging_node_constraints(dof_handler_, constraints);
+
+      constraints.close();
+    };
+
 #ifdef USE_SIMD
-    n_locally_internal_ = DoFRenumbering::internal_range(dof_handler_);
+    {
+      /*
+       * The vectorized index range is formed by groups of rows with equal
+       * row length. We thus need the constraints (in the current
+       * numbering) to determine the final row lengths:
+       */
+      AffineConstraints<Number> constraints;
+      make_constraints(constraints);
 
-    /* Round down to the nearest multiple of the VectorizedArray width: */
-    n_locally_internal_ = n_locally_internal_ -
-                          n_locally_internal_ % VectorizedArray<Number>::size();
+#ifdef USE_COMMUNICATION_HIDING
+      n_locally_internal_ =
+          DoFRenumbering::internal_range(dof_handler_,
+                                         constraints,
+                                         VectorizedArray<Number>::size(),
+                                         n_export_indices_preliminary);
+#else
+      n_locally_internal_ = DoFRenumbering::internal_range(
+          dof_handler_, constraints, VectorizedArray<Number>::size());
+#endif
+
+      Assert(n_locally_internal_ % VectorizedArray<Number>::size() == 0,
+             dealii::ExcInternalError());
+    }
 #else
     /*
      * If USE_SIMD is not set, we disable all SIMD instructions by
@@ -117,31 +185,7 @@ namespace ryujin
 
     /* Set up affine constraints object: */
 
-    affine_constraints_.reinit(locally_relevant);
-
-    const auto n_periodic_faces =
-        discretization_->triangulation().get_periodic_face_map().size();
-    if (n_periodic_faces != 0) {
-      /*
-       * Enforce periodic boundary conditions. We assume that the mesh is in
-       * "normal configuration". By convention we also omit enforcing
-       * periodicity in x direction. This avoids accidentally glueing the
-       * corner degrees of freedom together which leads to instability.
-       */
-      if constexpr (dim != 1 && std::is_same<Number, double>::value) {
-        for (int i = 1; i < dim; ++i) /* omit x direction! */
-          DoFTools::make_periodicity_constraints(dof_handler_,
-                                                 /*b_id */ Boundary::periodic,
-                                                 /*direction*/ i,
-                                                 affine_constraints_);
-      } else {
-        AssertThrow(false, dealii::ExcNotImplemented());
-      }
-    }
-
-    DoFTools::make_hanging_node_constraints(dof_handler_, affine_constraints_);
-
-    affine_constraints_.close();
+    make_constraints(affine_constraints_);
 
     affine_constraints_assembly_.copy_from(affine_constraints_);
     transform_to_local_range(*scalar_partitioner_,
@@ -164,12 +208,22 @@ namespace ryujin
 
     /* Next we can (re)initialize all local matrices: */
 
-    lumped_mass_matrix_.reinit(scalar_partitioner_);
-    lumped_mass_matrix_inverse_.reinit(scalar_partitioner_);
+    reinit_first_touch(lumped_mass_matrix_,
+                       scalar_partitioner_,
+                       n_locally_internal_,
+                       n_locally_owned_);
+    reinit_first_touch(lumped_mass_matrix_inverse_,
+                       scalar_partitioner_,
+                       n_locally_internal_,
+                       n_locally_owned_);
 
     mass_matrix_.reinit(sparsity_pattern_simd_);
     betaij_matrix_.reinit(sparsity_pattern_simd_);
     cij_matrix_.reinit(sparsity_pattern_simd_);
+#ifdef USE_PRECOMPUTED_NORMALS
+    cij_norm_matrix_.reinit(sparsity_pattern_simd_);
+    nij_matrix_.reinit(sparsity_pattern_simd_);
+#endif
   }
 
 
@@ -396,6 +450,28 @@ namespace ryujin
       normal /= (normal.norm() + std::numeric_limits<Number>::epsilon());
     }
 
+    boundary_table_.reinit(n_locally_relevant_, boundary_map_);
+
+    /*
+     * Record which SIMD row groups consist of boundary degrees of
+     * freedom. By construction of the internal range (see
+     * DoFRenumbering::internal_range()) either all or none of the degrees
+     * of freedom of a group are situated at the boundary:
+     */
+    {
+      constexpr auto simd_length = VectorizedArray<Number>::size();
+      boundary_row_groups_.resize(n_locally_internal_ / simd_length);
+      for (unsigned int i = 0; i < n_locally_internal_; i += simd_length) {
+        boundary_row_groups_[i / simd_length] = boundary_table_.is_boundary(i);
+#ifdef DEBUG
+        for (unsigned int k = 1; k < simd_length; ++k)
+          Assert(boundary_table_.is_boundary(i + k) ==
+                     boundary_row_groups_[i / simd_length],
+                 dealii::ExcInternalError());
+#endif
+      }
+    }
+
     /*
      * Second pass: Fix up boundary cijs:
      */
@@ -492,6 +568,29 @@ namespace ryujin
     betaij_matrix_.read_in(betaij_matrix_tmp);
     mass_matrix_.read_in(mass_matrix_tmp);
     cij_matrix_.read_in(cij_matrix_tmp);
+
+#ifdef USE_PRECOMPUTED_NORMALS
+    /*
+     * Precompute norms and unit normals of the (final) c_ij matrix:
+     */
+    for (unsigned int i = 0; i < n_locally_relevant_; ++i) {
+      const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+        const auto c_ij = cij_matrix_.get_tensor(i, col_idx);
+        const Number norm = c_ij.norm();
+        cij_norm_matrix_.write_entry(norm, i, col_idx);
+        nij_matrix_.write_tensor(
+            norm == Number(0.) ? dealii::Tensor<1, dim, Number>() : c_ij / norm,
+            i,
+            col_idx);
+      }
+    }
+#endif
+
+#ifdef USE_EDGE_DIJ
+    edge_list_.reinit(
+        n_locally_owned_, sparsity_pattern_simd_, cij_matrix_, boundary_map_);
+#endif
   }
 
 } /* namespace ryujin */
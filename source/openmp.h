@@ -9,9 +9,13 @@
 #include <compile_time_options.h>
 
 #include <deal.II/base/config.h>
+#include <deal.II/base/exceptions.h>
 
+#include <algorithm>
 #include <atomic>
 #include <omp.h>
+#include <utility>
+#include <vector>
 
 /**
  * @name OpenMP parallel for macros
@@ -32,6 +36,12 @@
  *
  * RYUJIN_PARALLEL_REGION_END
  * ```
+ *
+ * RYUJIN_OMP_FOR and RYUJIN_OMP_FOR_NOWAIT explicitly request a static
+ * schedule. This guarantees that two loops with the same iteration space
+ * assign every iteration to the same thread (for the same number of
+ * threads). We rely on this for NUMA aware first-touch initialization,
+ * see reinit_first_touch().
  */
 //@{
 
@@ -64,7 +74,7 @@
  *
  * @ingroup Miscellaneous
  */
-#define RYUJIN_OMP_FOR RYUJIN_PRAGMA(omp for)
+#define RYUJIN_OMP_FOR RYUJIN_PRAGMA(omp for schedule(static))
 
 /**
  * Enter a parallel for loop with "nowait" declaration, i.e., the end of
@@ -73,7 +83,27 @@
  *
  * @ingroup Miscellaneous
  */
-#define RYUJIN_OMP_FOR_NOWAIT RYUJIN_PRAGMA(omp for nowait)
+#define RYUJIN_OMP_FOR_NOWAIT RYUJIN_PRAGMA(omp for schedule(static) nowait)
+
+/**
+ * Enter a parallel for loop with "nowait" declaration that hands out
+ * chunks of @p chunk_size iterations dynamically to the worker threads,
+ * i.e., a thread that finished its chunk grabs the next unprocessed one.
+ * This requires the compile-time option USE_DYNAMIC_SCHEDULING. Without
+ * it, the macro expands to RYUJIN_OMP_FOR_NOWAIT and @p chunk_size is
+ * ignored.
+ *
+ * @note A dynamic schedule does not preserve the thread to row mapping
+ * established by first-touch initialization.
+ *
+ * @ingroup Miscellaneous
+ */
+#ifdef USE_DYNAMIC_SCHEDULING
+#define RYUJIN_OMP_FOR_DYNAMIC_NOWAIT(chunk_size)                             \
+  RYUJIN_PRAGMA(omp for schedule(dynamic, chunk_size) nowait)
+#else
+#define RYUJIN_OMP_FOR_DYNAMIC_NOWAIT(chunk_size) RYUJIN_OMP_FOR_NOWAIT
+#endif
 
 /**
  * Declare an explicit Thread synchronization barrier.
@@ -82,6 +112,15 @@
  */
 #define RYUJIN_OMP_BARRIER RYUJIN_PRAGMA(omp barrier)
 
+/**
+ * Enter a structured block that is executed by only one thread of the
+ * team. The end of the block includes an implicit thread synchronization
+ * barrier.
+ *
+ * @ingroup Miscellaneous
+ */
+#define RYUJIN_OMP_SINGLE RYUJIN_PRAGMA(omp single)
+
 /**
  * Compiler hint annotating a boolean to be likely true.
  *
@@ -133,8 +172,21 @@ public:
 
   ~SynchronizationDispatch()
   {
-    if (!executed_payload_)
+    flush();
+  }
+
+  /**
+   * Execute the payload unless this has already happened. This function
+   * must not be called concurrently with check(), i.e., only by a single
+   * thread after a thread synchronization barrier, or outside of a
+   * parallel region.
+   */
+  void flush()
+  {
+    if (!executed_payload_) {
+      executed_payload_ = true;
       payload_();
+    }
   }
 
   DEAL_II_ALWAYS_INLINE inline void check(bool &thread_ready,
@@ -161,6 +213,399 @@ private:
   std::atomic_int n_threads_ready_;
 };
 
+
+/**
+ * A partition of the work items of a parallel loop (rows, or SIMD row
+ * groups) into possibly overlapping "chunks". Every chunk is typically
+ * associated with a neighboring MPI rank and consists of all work items
+ * that have to be completed before the halo exchange message for that
+ * rank can be sent. See ChunkedSynchronizationDispatch.
+ *
+ * @ingroup Miscellaneous
+ */
+class SynchronizationChunks
+{
+public:
+  /**
+   * Set up the partition for @p n_items work items and
+   * chunk_items.size() chunks. Chunk c consists of the work items stored
+   * in chunk_items[c]. Duplicate entries are ignored.
+   */
+  void reinit(const unsigned int n_items,
+              const std::vector<std::vector<unsigned int>> &chunk_items)
+  {
+    chunk_sizes_.assign(chunk_items.size(), 0);
+
+    /* Count the number of distinct chunks per item: */
+    std::vector<unsigned int> last_chunk(n_items, -1u);
+    item_starts_.assign(n_items + 1, 0);
+    for (unsigned int c = 0; c < chunk_items.size(); ++c)
+      for (const auto item : chunk_items[c]) {
+        Assert(item < n_items, dealii::ExcIndexRange(item, 0, n_items));
+        if (last_chunk[item] == c)
+          continue;
+        last_chunk[item] = c;
+        ++item_starts_[item + 1];
+        ++chunk_sizes_[c];
+      }
+
+    for (unsigned int i = 0; i < n_items; ++i)
+      item_starts_[i + 1] += item_starts_[i];
+
+    item_chunks_.resize(item_starts_[n_items]);
+    std::vector<unsigned int> position(item_starts_.begin(),
+                                       item_starts_.end() - 1);
+    std::fill(last_chunk.begin(), last_chunk.end(), -1u);
+    for (unsigned int c = 0; c < chunk_items.size(); ++c)
+      for (const auto item : chunk_items[c]) {
+        if (last_chunk[item] == c)
+          continue;
+        last_chunk[item] = c;
+        item_chunks_[position[item]++] = c;
+      }
+  }
+
+  unsigned int n_chunks() const
+  {
+    return chunk_sizes_.size();
+  }
+
+  /**
+   * Number of distinct work items of chunk @p chunk.
+   */
+  unsigned int chunk_size(const unsigned int chunk) const
+  {
+    return chunk_sizes_[chunk];
+  }
+
+  /**
+   * Return the half open range of chunks (as pointers into a contiguous
+   * array) that contain work item @p item.
+   */
+  DEAL_II_ALWAYS_INLINE inline std::pair<const unsigned int *,
+                                         const unsigned int *>
+  chunks_of(const unsigned int item) const
+  {
+    const unsigned int *begin = item_chunks_.data();
+    return {begin + item_starts_[item], begin + item_starts_[item + 1]};
+  }
+
+private:
+  std::vector<unsigned int> item_starts_;
+  std::vector<unsigned int> item_chunks_;
+  std::vector<unsigned int> chunk_sizes_;
+};
+
+
+/**
+ * A variant of SynchronizationDispatch that executes the payload for
+ * every chunk of a SynchronizationChunks partition individually as soon
+ * as all work items of the chunk have been completed. The payload is
+ * executed by the thread completing the last work item of the chunk.
+ * In contrast to SynchronizationDispatch a chunk therefore does not
+ * have to wait for the slowest thread of the team to leave the export
+ * range.
+ *
+ * Intended use:
+ * ```
+ * ChunkedSynchronizationDispatch dispatch(chunks, [&](unsigned int c) {
+ *   // send halo exchange message c
+ * });
+ *
+ * RYUJIN_PARALLEL_REGION_BEGIN
+ * RYUJIN_OMP_FOR
+ * for (unsigned int i = 0; i < n_items; ++i) {
+ *   // work on item i
+ *   dispatch.check(i);
+ * }
+ * RYUJIN_PARALLEL_REGION_END
+ *
+ * dispatch.flush();
+ * ```
+ *
+ * @note The payload is executed concurrently by different threads. If
+ * it calls into MPI, this either requires MPI_THREAD_MULTIPLE, or the
+ * payload has to serialize all MPI calls itself.
+ *
+ * @ingroup Miscellaneous
+ */
+template <typename Payload>
+class ChunkedSynchronizationDispatch
+{
+public:
+  ChunkedSynchronizationDispatch(const SynchronizationChunks &chunks,
+                                 const Payload &payload)
+      : chunks_(chunks)
+      , payload_(payload)
+      , n_items_remaining_(chunks.n_chunks())
+  {
+    for (unsigned int c = 0; c < chunks.n_chunks(); ++c)
+      n_items_remaining_[c].store(chunks.chunk_size(c),
+                                  std::memory_order_relaxed);
+  }
+
+  ~ChunkedSynchronizationDispatch()
+  {
+    flush();
+  }
+
+  /**
+   * Execute the payload for all chunks for which this has not happened
+   * yet (including empty chunks). This function must not be called
+   * concurrently with check(), i.e., only by a single thread after a
+   * thread synchronization barrier, or outside of a parallel region.
+   */
+  void flush()
+  {
+    for (unsigned int c = 0; c < n_items_remaining_.size(); ++c)
+      if (n_items_remaining_[c].exchange(-1, std::memory_order_acquire) >= 0)
+        payload_(c);
+  }
+
+  /**
+   * Record that work item @p item has been completed by the calling
+   * thread. Every work item must be recorded at most once.
+   */
+  DEAL_II_ALWAYS_INLINE inline void check(const unsigned int item)
+  {
+#ifdef USE_COMMUNICATION_HIDING
+    const auto [begin, end] = chunks_.chunks_of(item);
+    for (auto it = begin; it != end; ++it) {
+      /*
+       * The acquire-release semantics ensures that the writes of all
+       * threads that completed an item of this chunk are visible to the
+       * thread executing the payload:
+       */
+      auto &n_items_remaining = n_items_remaining_[*it];
+      if (n_items_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        payload_(*it);
+        /* Mark the payload as executed: */
+        n_items_remaining.store(-1, std::memory_order_relaxed);
+      }
+    }
+#else
+    (void)item;
+#endif
+  }
+
+private:
+  const SynchronizationChunks &chunks_;
+  const Payload payload_;
+  std::vector<std::atomic_int> n_items_remaining_;
+};
+
+
+/**
+ * Accumulate the time every thread spends working ("busy") and waiting in
+ * thread synchronization barriers ("idle") in a parallel region.
+ *
+ * Intended use:
+ * ```
+ * RYUJIN_PARALLEL_REGION_BEGIN
+ * statistics.begin();
+ *
+ * RYUJIN_OMP_FOR_NOWAIT
+ * for (unsigned int i = 0; i < size; ++i) {
+ *   // ...
+ * }
+ *
+ * statistics.barrier(); // replaces the implicit barrier of the loop
+ *
+ * RYUJIN_PARALLEL_REGION_END
+ * ```
+ *
+ * The function reinit() has to be called outside of a parallel region
+ * prior to use.
+ *
+ * @ingroup Miscellaneous
+ */
+class LoadBalanceStatistics
+{
+public:
+  /**
+   * Allocate storage for omp_get_max_threads() threads and reset all
+   * recorded times to zero.
+   */
+  void reinit()
+  {
+    entries_.assign(omp_get_max_threads(), Entry());
+  }
+
+  /**
+   * Start the busy timer of the calling thread.
+   */
+  DEAL_II_ALWAYS_INLINE inline void begin()
+  {
+    entries_[omp_get_thread_num()].mark = omp_get_wtime();
+  }
+
+  /**
+   * Stop the busy timer of the calling thread, wait in an explicit thread
+   * synchronization barrier, and restart the busy timer.
+   */
+  DEAL_II_ALWAYS_INLINE inline void barrier()
+  {
+    auto &entry = entries_[omp_get_thread_num()];
+    const double time = omp_get_wtime();
+    entry.busy += time - entry.mark;
+    RYUJIN_OMP_BARRIER
+    entry.mark = omp_get_wtime();
+    entry.idle += entry.mark - time;
+  }
+
+  /**
+   * Stop the busy timer of the calling thread without synchronization.
+   */
+  DEAL_II_ALWAYS_INLINE inline void end()
+  {
+    auto &entry = entries_[omp_get_thread_num()];
+    entry.busy += omp_get_wtime() - entry.mark;
+  }
+
+  /**
+   * Stop the busy timer of the calling thread, execute @p function (that
+   * blocks until a point-to-point dependency is satisfied, see
+   * BlockProgress), and restart the busy timer. The time spent in
+   * @p function is accounted as idle time.
+   */
+  template <typename Function>
+  DEAL_II_ALWAYS_INLINE inline void wait(const Function &function)
+  {
+    auto &entry = entries_[omp_get_thread_num()];
+    const double time = omp_get_wtime();
+    entry.busy += time - entry.mark;
+    function();
+    entry.mark = omp_get_wtime();
+    entry.idle += entry.mark - time;
+  }
+
+  unsigned int n_threads() const
+  {
+    return entries_.size();
+  }
+
+  /**
+   * Accumulated busy time of thread @p thread (in seconds).
+   */
+  double busy(const unsigned int thread) const
+  {
+    return entries_[thread].busy;
+  }
+
+  /**
+   * Accumulated idle time of thread @p thread (in seconds).
+   */
+  double idle(const unsigned int thread) const
+  {
+    return entries_[thread].idle;
+  }
+
+private:
+  /* Padded to a cache line in order to avoid false sharing: */
+  struct alignas(64) Entry {
+    double mark = 0.;
+    double busy = 0.;
+    double idle = 0.;
+  };
+
+  std::vector<Entry> entries_;
+};
+
+
+/**
+ * Progress counters for a dataflow execution of consecutive loops over
+ * row blocks within a single parallel region.
+ *
+ * Instead of separating two loops by a thread synchronization barrier,
+ * every block records the last step that has been completed on it with
+ * mark(). A thread about to process a block in the next step calls
+ * wait() for all blocks the computation depends on (typically all blocks
+ * containing a column index of one of its rows).
+ *
+ * Intended use:
+ * ```
+ * progress.reset(); // outside of the parallel region
+ *
+ * RYUJIN_PARALLEL_REGION_BEGIN
+ *
+ * RYUJIN_OMP_FOR_NOWAIT
+ * for (unsigned int block = 0; block < n_blocks; ++block) {
+ *   // step 1 on block
+ *   progress.mark(block, 1);
+ * }
+ *
+ * RYUJIN_OMP_FOR_NOWAIT
+ * for (unsigned int block = 0; block < n_blocks; ++block) {
+ *   for (const auto dependency : dependencies[block])
+ *     progress.wait(dependency, 1);
+ *   // step 2 on block
+ * }
+ *
+ * RYUJIN_PARALLEL_REGION_END
+ * ```
+ *
+ * Every thread has to process all of its blocks of one step before
+ * moving on to the next step, i.e., waits may only refer to the previous
+ * step. This ensures progress for static as well as dynamic schedules.
+ *
+ * @ingroup Miscellaneous
+ */
+class BlockProgress
+{
+public:
+  /**
+   * Allocate counters for @p n_blocks blocks and reset them to zero. Has
+   * to be called outside of a parallel region.
+   */
+  void reinit(const unsigned int n_blocks)
+  {
+    entries_ = std::vector<Entry>(n_blocks);
+  }
+
+  /**
+   * Reset all counters to zero. Has to be called outside of a parallel
+   * region.
+   */
+  void reset()
+  {
+    for (auto &entry : entries_)
+      entry.step.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * Record that @p step has been completed on @p block. All writes of
+   * the calling thread prior to the call are visible to every thread
+   * that subsequently returns from wait(block, step).
+   */
+  DEAL_II_ALWAYS_INLINE inline void mark(const unsigned int block,
+                                         const unsigned int step)
+  {
+    entries_[block].step.store(step, std::memory_order_release);
+  }
+
+  /**
+   * Spin until @p step has been completed on @p block.
+   */
+  DEAL_II_ALWAYS_INLINE inline void wait(const unsigned int block,
+                                         const unsigned int step) const
+  {
+    while (RYUJIN_UNLIKELY(entries_[block].step.load(
+                               std::memory_order_acquire) < step)) {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#endif
+    }
+  }
+
+private:
+  /* Padded to a cache line in order to avoid false sharing: */
+  struct alignas(64) Entry {
+    std::atomic<unsigned int> step{0};
+  };
+
+  std::vector<Entry> entries_;
+};
+
 //@}
 
 #endif /* OPENMP_H */
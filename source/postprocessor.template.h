@@ -120,7 +120,7 @@ namespace ryujin
     const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
     const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
     const auto &cij_matrix = offline_data_->cij_matrix();
-    const auto &boundary_map = offline_data_->boundary_map();
+    const auto &boundary_table = offline_data_->boundary_table();
 
     const unsigned int n_internal = offline_data_->n_locally_internal();
     const unsigned int n_locally_owned = offline_data_->n_locally_owned();
@@ -178,11 +178,11 @@ namespace ryujin
 
         /* Fix up boundaries: */
 
-        const auto bnm_it = boundary_map.find(i);
-        if (bnm_it != boundary_map.end()) {
-          const auto [normal, id, _] = bnm_it->second;
+        if (boundary_table.is_boundary(i)) {
+          const unsigned int slot = boundary_table.slot(i);
+          const auto normal = boundary_table.normal(slot);
           /* FIXME: Think again about what to do exactly here... */
-          if (id == Boundary::slip) {
+          if (boundary_table.id(slot) == Boundary::slip) {
             grad_rho_i -= 1. * (grad_rho_i * normal) * normal;
           } else {
             grad_rho_i = 0.;
@@ -60,6 +60,21 @@ namespace ryujin
     using rank2_type =
         dealii::Tensor<1, problem_dimension, dealii::Tensor<1, dim, Number>>;
 
+
+    /**
+     * The number of node-wise precomputed values, see
+     * precompute_values(): the flux \f$\mathbf{f}\f$ (flattened), the
+     * inverse density, the pressure, and the speed of sound.
+     */
+    static constexpr unsigned int n_precomputed_values =
+        problem_dimension * dim + 3;
+
+
+    /**
+     * The storage type used for node-wise precomputed values.
+     */
+    using precomputed_type = dealii::Tensor<1, n_precomputed_values, Number>;
+
     /**
      * @name ProblemDescription compile time options
      */
@@ -223,6 +238,47 @@ namespace ryujin
      * \f]
      */
     static rank2_type f(const rank1_type &U);
+
+
+    /**
+     * @name Node-wise precomputed values
+     *
+     * All quantities derived from a state @p U that are needed by the
+     * Indicator, the RiemannSolver, and the low-order update can be
+     * computed once per node and stored in a
+     * MultiComponentVector<Number, n_precomputed_values>. The following
+     * functions pack and unpack such a vector entry.
+     */
+    //@{
+
+    /**
+     * For a given state @p U compute the flux \f$\mathbf{f}(\boldsymbol
+     * U)\f$, the inverse density \f$1/\rho\f$, the pressure \f$p\f$, and
+     * the speed of sound \f$c\f$ and return them in a single tensor.
+     */
+    static precomputed_type precompute_values(const rank1_type &U);
+
+    /**
+     * Return the flux stored in a precomputed tensor.
+     */
+    static rank2_type f(const precomputed_type &precomputed);
+
+    /**
+     * Return the inverse density stored in a precomputed tensor.
+     */
+    static Number rho_inverse(const precomputed_type &precomputed);
+
+    /**
+     * Return the pressure stored in a precomputed tensor.
+     */
+    static Number pressure(const precomputed_type &precomputed);
+
+    /**
+     * Return the speed of sound stored in a precomputed tensor.
+     */
+    static Number speed_of_sound(const precomputed_type &precomputed);
+
+    //@}
   };
 
   /* Inline definitions */
@@ -451,6 +507,76 @@ namespace ryujin
   }
 
 
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline
+      typename ProblemDescription<dim, Number>::precomputed_type
+      ProblemDescription<dim, Number>::precompute_values(const rank1_type &U)
+  {
+    const Number rho_inverse = ScalarNumber(1.) / U[0];
+    const auto m = momentum(U);
+    const auto p = pressure(U);
+    const Number E = U[dim + 1];
+
+    precomputed_type result;
+
+    /* Flux, see f(): */
+    for (unsigned int d = 0; d < dim; ++d) {
+      result[d] = m[d];
+      for (unsigned int i = 0; i < dim; ++i)
+        result[(1 + i) * dim + d] = m[d] * (m[i] * rho_inverse);
+      result[(1 + d) * dim + d] += p;
+      result[(dim + 1) * dim + d] = m[d] * (rho_inverse * (E + p));
+    }
+
+    constexpr unsigned int offset = problem_dimension * dim;
+    result[offset] = rho_inverse;
+    result[offset + 1] = p;
+    result[offset + 2] = std::sqrt(gamma * p * rho_inverse);
+
+    return result;
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline
+      typename ProblemDescription<dim, Number>::rank2_type
+      ProblemDescription<dim, Number>::f(const precomputed_type &precomputed)
+  {
+    rank2_type result;
+    for (unsigned int k = 0; k < problem_dimension; ++k)
+      for (unsigned int d = 0; d < dim; ++d)
+        result[k][d] = precomputed[k * dim + d];
+    return result;
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline Number
+  ProblemDescription<dim, Number>::rho_inverse(
+      const precomputed_type &precomputed)
+  {
+    return precomputed[problem_dimension * dim];
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline Number
+  ProblemDescription<dim, Number>::pressure(
+      const precomputed_type &precomputed)
+  {
+    return precomputed[problem_dimension * dim + 1];
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline Number
+  ProblemDescription<dim, Number>::speed_of_sound(
+      const precomputed_type &precomputed)
+  {
+    return precomputed[problem_dimension * dim + 2];
+  }
+
+
 } /* namespace ryujin */
 
 #endif /* PROBLEM_DESCRIPTION_H */
@@ -45,6 +45,12 @@ namespace ryujin
      */
     using rank1_type = typename ProblemDescription<dim, Number>::rank1_type;
 
+    /**
+     * @copydoc ProblemDescription::precomputed_type
+     */
+    using precomputed_type =
+        typename ProblemDescription<dim, Number>::precomputed_type;
+
     /**
      * @copydoc ProblemDescription::ScalarNumber
      */
@@ -122,7 +128,37 @@ namespace ryujin
             const dealii::Tensor<1, dim, Number> &n_ij,
             const Number hd_i = Number(0.));
 
+    /**
+     * Variant of above function that takes the node-wise precomputed
+     * values (see ProblemDescription::precompute_values()) of both states
+     * as additional arguments. This avoids recomputing pressure and speed
+     * of sound for every Riemann problem.
+     */
+    static std::tuple<Number /*lambda_max*/,
+                      Number /*p_star*/,
+                      unsigned int /*iteration*/>
+    compute(const rank1_type &U_i,
+            const rank1_type &U_j,
+            const precomputed_type &precomputed_i,
+            const precomputed_type &precomputed_j,
+            const dealii::Tensor<1, dim, Number> &n_ij,
+            const Number hd_i = Number(0.));
+
     //@}
+
+  private:
+    /**
+     * Compute lambda max for given states U_i and U_j and corresponding
+     * Riemann data. Performs the (optional) greedy improvement of the
+     * wavespeed estimate.
+     */
+    static std::tuple<Number, Number, unsigned int>
+    compute(const rank1_type &U_i,
+            const rank1_type &U_j,
+            const std::array<Number, 4> &riemann_data_i,
+            const std::array<Number, 4> &riemann_data_j,
+            const dealii::Tensor<1, dim, Number> &n_ij,
+            const Number hd_i);
   };
 
 } /* namespace ryujin */
@@ -681,6 +681,29 @@ namespace ryujin
               ProblemDescription<1, Number>::pressure(projected),
               ProblemDescription<1, Number>::speed_of_sound(projected)};
     }
+
+
+    /**
+     * Variant of above function using node-wise precomputed values. The
+     * pressure and the speed of sound are invariant under the projection,
+     * thus only the normal velocity has to be computed.
+     */
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline std::array<Number, 4>
+    riemann_data_from_precomputed(
+        const typename ProblemDescription<dim, Number>::rank1_type &U,
+        const typename ProblemDescription<dim, Number>::precomputed_type
+            &precomputed,
+        const dealii::Tensor<1, dim, Number> &n_ij)
+    {
+      using PD = ProblemDescription<dim, Number>;
+      const auto m = PD::momentum(U);
+
+      return {U[0],                                      // rho
+              (n_ij * m) * PD::rho_inverse(precomputed), // u
+              PD::pressure(precomputed),
+              PD::speed_of_sound(precomputed)};
+    }
   } /* anonymous namespace */
 
 
@@ -698,6 +721,42 @@ namespace ryujin
     const auto riemann_data_i = riemann_data_from_state(U_i, n_ij);
     const auto riemann_data_j = riemann_data_from_state(U_j, n_ij);
 
+    return compute(U_i, U_j, riemann_data_i, riemann_data_j, n_ij, hd_i);
+  }
+
+
+  template <int dim, typename Number>
+#ifdef OBSESSIVE_INLINING
+  DEAL_II_ALWAYS_INLINE inline
+#endif
+      std::tuple<Number, Number, unsigned int>
+      RiemannSolver<dim, Number>::compute(
+          const rank1_type &U_i,
+          const rank1_type &U_j,
+          const precomputed_type &precomputed_i,
+          const precomputed_type &precomputed_j,
+          const dealii::Tensor<1, dim, Number> &n_ij,
+          const Number hd_i)
+  {
+    const auto riemann_data_i =
+        riemann_data_from_precomputed(U_i, precomputed_i, n_ij);
+    const auto riemann_data_j =
+        riemann_data_from_precomputed(U_j, precomputed_j, n_ij);
+
+    return compute(U_i, U_j, riemann_data_i, riemann_data_j, n_ij, hd_i);
+  }
+
+
+  template <int dim, typename Number>
+  DEAL_II_ALWAYS_INLINE inline std::tuple<Number, Number, unsigned int>
+  RiemannSolver<dim, Number>::compute(
+      const rank1_type &U_i,
+      const rank1_type &U_j,
+      const std::array<Number, 4> &riemann_data_i,
+      const std::array<Number, 4> &riemann_data_j,
+      const dealii::Tensor<1, dim, Number> &n_ij,
+      const Number hd_i)
+  {
     if constexpr (!greedy_dij_) {
       return compute(riemann_data_i, riemann_data_j);
     }
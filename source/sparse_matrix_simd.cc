@@ -23,4 +23,25 @@ namespace ryujin
   template class SparseMatrixSIMD<NUMBER,
                                   ProblemDescription<DIM>::problem_dimension>;
 
+#if defined(USE_MIXED_PRECISION) || defined(USE_MIXED_PRECISION_OFFLINE)
+  template class SparseMatrixSIMD<NUMBER,
+                                  1,
+                                  dealii::VectorizedArray<NUMBER>::size(),
+                                  float>;
+#endif
+
+#if defined(USE_MIXED_PRECISION_OFFLINE) && DIM != 1
+  template class SparseMatrixSIMD<NUMBER,
+                                  DIM,
+                                  dealii::VectorizedArray<NUMBER>::size(),
+                                  float>;
+#endif
+
+#ifdef USE_MIXED_PRECISION_PIJ
+  template class SparseMatrixSIMD<NUMBER,
+                                  ProblemDescription<DIM>::problem_dimension,
+                                  dealii::VectorizedArray<NUMBER>::size(),
+                                  float>;
+#endif
+
 } /* namespace ryujin */
@@ -10,14 +10,18 @@
 #include <deal.II/base/partitioner.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 
+#include "numa.h"
 #include "openmp.h"
 #include "simd.h"
 
+#include <type_traits>
+
 namespace ryujin
 {
   template <typename Number,
             int n_components = 1,
-            int simd_length = dealii::VectorizedArray<Number>::size()>
+            int simd_length = dealii::VectorizedArray<Number>::size(),
+            typename StorageNumber = Number>
   class SparseMatrixSIMD;
 
   /**
@@ -38,6 +42,14 @@ namespace ryujin
    *    format, i.e., row-by-row (or row-chunk-per-row-chunk) and along
    *    columns, following the sparsity pattern.
    *
+   * The vectorized row index region consists of groups of simd_length
+   * consecutive rows, [i, i + simd_length) with i a multiple of
+   * simd_length. The row length is constant within a group but may vary
+   * from group to group (see DoFRenumbering::internal_range() for how
+   * such groups are formed). This way rows with non-standard
+   * connectivity (irregular vertices, hanging nodes, boundary rows,
+   * higher order ansatz spaces) can be vectorized as well.
+   *
    * For the non-vectorized row index region [n_internal_dofs,
    * n_locally_relevant_dofs) we store the matrix in CSR format (equivalent
    * to the static dealii::SparsityPattern).
@@ -70,6 +82,12 @@ namespace ryujin
 
     std::size_t n_nonzero_elements() const;
 
+    /**
+     * Return the number of memory pages of the column index array that
+     * reside on NUMA node k in entry k, see ryujin::page_placement().
+     */
+    std::vector<std::size_t> page_placement() const;
+
   private:
     unsigned int n_internal_dofs;
     unsigned int n_locally_owned_dofs;
@@ -83,7 +101,7 @@ namespace ryujin
     std::vector<std::pair<unsigned int, unsigned int>> receive_targets;
     MPI_Comm mpi_communicator;
 
-    template <typename, int, int>
+    template <typename, int, int, typename>
     friend class SparseMatrixSIMD;
   };
 
@@ -96,8 +114,17 @@ namespace ryujin
    * SparsityPatternSIMD for details). For the non-vectorized row index
    * region [n_internal_dofs, n_locally_relevant_dofs) we store the matrix in
    * CSR format (equivalent to the static dealii::SparsityPattern).
+   *
+   * The matrix entries are stored in the (possibly lower precision) type
+   * StorageNumber but all getter and setter functions operate on Number,
+   * i.e., entries are converted on load and on store. This allows, for
+   * example, to hold matrices in single precision while all arithmetic is
+   * performed in double precision.
    */
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   class SparseMatrixSIMD
   {
   public:
@@ -105,6 +132,12 @@ namespace ryujin
 
     SparseMatrixSIMD(const SparsityPatternSIMD<simd_length> &sparsity);
 
+    /* The matrix owns persistent MPI requests referring to its storage: */
+    SparseMatrixSIMD(const SparseMatrixSIMD &) = delete;
+    SparseMatrixSIMD &operator=(const SparseMatrixSIMD &) = delete;
+
+    ~SparseMatrixSIMD();
+
     void reinit(const SparsityPatternSIMD<simd_length> &sparsity);
 
     void read_in(const std::array<dealii::SparseMatrix<Number>, n_components>
@@ -167,17 +200,42 @@ namespace ryujin
         const unsigned int position_within_column,
         const bool do_streaming_store = false);
 
-    /* Synchronize over MPI ranks: */
+    /*
+     * Synchronize over MPI ranks. Persistent MPI requests are set up on
+     * first use and are reused for all subsequent calls with the same
+     * communication_channel:
+     */
 
     void update_ghost_rows_start(const unsigned int communication_channel = 0);
     void update_ghost_rows_finish();
     void update_ghost_rows();
 
+    /*
+     * Alternatively, start receiving ghost rows only and send the rows
+     * for every send target individually with update_ghost_rows_send()
+     * once they have been computed. The exchange is completed with
+     * update_ghost_rows_finish():
+     */
+
+    void update_ghost_rows_start_receives(
+        const unsigned int communication_channel = 0);
+    void update_ghost_rows_send(const unsigned int target);
+
+    /**
+     * Return the number of memory pages of the matrix entries that reside
+     * on NUMA node k in entry k, see ryujin::page_placement().
+     */
+    std::vector<std::size_t> page_placement() const;
+
   private:
+    void setup_requests(const unsigned int communication_channel);
+    void free_requests();
+
     const SparsityPatternSIMD<simd_length> *sparsity;
-    dealii::AlignedVector<Number> data;
-    dealii::AlignedVector<Number> exchange_buffer;
+    dealii::AlignedVector<StorageNumber> data;
+    dealii::AlignedVector<StorageNumber> exchange_buffer;
     std::vector<MPI_Request> requests;
+    int persistent_tag;
   };
 
   /*
@@ -245,19 +303,49 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <int simd_length>
+  inline std::vector<std::size_t>
+  SparsityPatternSIMD<simd_length>::page_placement() const
+  {
+    return ryujin::page_placement(column_indices.data(),
+                                  column_indices.size() * sizeof(unsigned int));
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline std::vector<std::size_t>
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      page_placement() const
+  {
+    return ryujin::page_placement(data.data(),
+                                  data.size() * sizeof(StorageNumber));
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline Number
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_entry(
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::get_entry(
       const unsigned int row, const unsigned int position_within_column) const
   {
     return get_tensor(row, position_within_column)[0];
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number>
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_tensor(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_tensor(
+          const unsigned int row,
+          const unsigned int position_within_column) const
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
 
@@ -286,20 +374,30 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline dealii::VectorizedArray<Number, simd_length>
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_vectorized_entry(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_vectorized_entry(
+          const unsigned int row,
+          const unsigned int position_within_column) const
   {
     return get_vectorized_tensor(row, position_within_column)[0];
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline auto
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_vectorized_tensor(
-      const unsigned int row, const unsigned int position_within_column) const
-      -> dealii::Tensor<1, n_components, VectorizedArray>
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_vectorized_tensor(
+          const unsigned int row,
+          const unsigned int position_within_column) const
+          -> dealii::Tensor<1, n_components, VectorizedArray>
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
 
@@ -315,29 +413,46 @@ namespace ryujin
     dealii::
         Tensor<1, n_components, dealii::VectorizedArray<Number, simd_length>>
             result;
-    const Number *load_pos =
+    const StorageNumber *load_pos =
         data.data() + (sparsity->row_starts[row / simd_length] +
                        position_within_column * simd_length) *
                           n_components;
-    for (unsigned int d = 0; d < n_components; ++d)
-      result[d].load(load_pos + d * simd_length);
+    if constexpr (std::is_same<Number, StorageNumber>::value) {
+      for (unsigned int d = 0; d < n_components; ++d)
+        result[d].load(load_pos + d * simd_length);
+    } else {
+      /* Convert on load: */
+      for (unsigned int d = 0; d < n_components; ++d)
+        for (unsigned int k = 0; k < simd_length; ++k)
+          result[d][k] = load_pos[d * simd_length + k];
+    }
     return result;
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline Number
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_entry(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_transposed_entry(
+          const unsigned int row,
+          const unsigned int position_within_column) const
   {
     return get_transposed_tensor(row, position_within_column)[0];
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number>
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_tensor(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_transposed_tensor(
+          const unsigned int row,
+          const unsigned int position_within_column) const
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
 
@@ -390,9 +505,12 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline dealii::VectorizedArray<Number, simd_length>
-  SparseMatrixSIMD<Number, n_components, simd_length>::
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
       get_vectorized_transposed_entry(
           const unsigned int row,
           const unsigned int position_within_column) const
@@ -411,17 +529,27 @@ namespace ryujin
     const unsigned int offset = sparsity->row_starts[row / simd_length] +
                                 position_within_column * simd_length;
     dealii::VectorizedArray<Number, simd_length> result;
-    result.gather(data.data(), sparsity->indices_transposed.data() + offset);
+    if constexpr (std::is_same<Number, StorageNumber>::value) {
+      result.gather(data.data(), sparsity->indices_transposed.data() + offset);
+    } else {
+      /* Convert on load: */
+      for (unsigned int k = 0; k < simd_length; ++k)
+        result[k] = data[sparsity->indices_transposed[offset + k]];
+    }
     return result;
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_entry(
-      const Number entry,
-      const unsigned int row,
-      const unsigned int position_within_column)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      write_entry(
+          const Number entry,
+          const unsigned int row,
+          const unsigned int position_within_column)
   {
     dealii::Tensor<1, n_components, Number> result;
     result[0] = entry;
@@ -430,12 +558,16 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_tensor(
-      const dealii::Tensor<1, n_components, Number> &entry,
-      const unsigned int row,
-      const unsigned int position_within_column)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      write_tensor(
+          const dealii::Tensor<1, n_components, Number> &entry,
+          const unsigned int row,
+          const unsigned int position_within_column)
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
 
@@ -450,24 +582,28 @@ namespace ryujin
         data[(sparsity->row_starts[simd_row] +
               position_within_column * simd_length) *
                  n_components +
-             d * simd_length + simd_offset] = entry[d];
+             d * simd_length + simd_offset] = StorageNumber(entry[d]);
     } else {
       // go through standard part
       for (unsigned int d = 0; d < n_components; ++d)
         data[(sparsity->row_starts[row] + position_within_column) *
                  n_components +
-             d] = entry[d];
+             d] = StorageNumber(entry[d]);
     }
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_vectorized_entry(
-      const dealii::VectorizedArray<Number, simd_length> entry,
-      const unsigned int row,
-      const unsigned int position_within_column,
-      const bool do_streaming_store)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      write_vectorized_entry(
+          const dealii::VectorizedArray<Number, simd_length> entry,
+          const unsigned int row,
+          const unsigned int position_within_column,
+          const bool do_streaming_store)
   {
     dealii::Tensor<1, n_components, VectorizedArray> tensor;
     tensor[0] = entry;
@@ -477,13 +613,17 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_vectorized_tensor(
-      const dealii::Tensor<1, n_components, VectorizedArray> &entry,
-      const unsigned int row,
-      const unsigned int position_within_column,
-      const bool do_streaming_store)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      write_vectorized_tensor(
+          const dealii::Tensor<1, n_components, VectorizedArray> &entry,
+          const unsigned int row,
+          const unsigned int position_within_column,
+          const bool do_streaming_store)
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
 
@@ -495,22 +635,34 @@ namespace ryujin
     Assert(row % simd_length == 0,
            dealii::ExcMessage(
                "Access only supported for rows at the SIMD granularity"));
-    Number *store_pos = data.data() + (sparsity->row_starts[row / simd_length] +
-                                       position_within_column * simd_length) *
-                                          n_components;
-    if (do_streaming_store)
-      for (unsigned int d = 0; d < n_components; ++d)
-        entry[d].streaming_store(store_pos + d * simd_length);
-    else
+    StorageNumber *store_pos =
+        data.data() + (sparsity->row_starts[row / simd_length] +
+                       position_within_column * simd_length) *
+                          n_components;
+    if constexpr (std::is_same<Number, StorageNumber>::value) {
+      if (do_streaming_store)
+        for (unsigned int d = 0; d < n_components; ++d)
+          entry[d].streaming_store(store_pos + d * simd_length);
+      else
+        for (unsigned int d = 0; d < n_components; ++d)
+          entry[d].store(store_pos + d * simd_length);
+    } else {
+      /* Convert on store: */
+      (void)do_streaming_store;
       for (unsigned int d = 0; d < n_components; ++d)
-        entry[d].store(store_pos + d * simd_length);
+        for (unsigned int k = 0; k < simd_length; ++k)
+          store_pos[d * simd_length + k] = StorageNumber(entry[d][k]);
+    }
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows_start(
-      const unsigned int communication_channel)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      setup_requests(const unsigned int communication_channel)
   {
 #ifdef DEAL_II_WITH_MPI
     Assert(n_components == 1,
@@ -524,27 +676,67 @@ namespace ryujin
                dealii::Utilities::MPI::internal::Tags::partitioner_export_end,
            dealii::ExcInternalError());
 
-    const std::size_t n_indices = sparsity->indices_to_be_sent.size();
-    exchange_buffer.resize_fast(n_indices);
-
-    requests.resize(sparsity->receive_targets.size() +
-                    sparsity->send_targets.size());
-    {
-      const auto &targets = sparsity->receive_targets;
-      for (unsigned int p = 0; p < targets.size(); ++p) {
-        const int ierr = MPI_Irecv(
+    if (static_cast<int>(mpi_tag) != persistent_tag) {
+      const std::size_t n_indices = sparsity->indices_to_be_sent.size();
+      free_requests();
+      exchange_buffer.resize_fast(n_indices);
+      requests.resize(sparsity->receive_targets.size() +
+                          sparsity->send_targets.size(),
+                      MPI_REQUEST_NULL);
+
+      const auto &receive_targets = sparsity->receive_targets;
+      for (unsigned int p = 0; p < receive_targets.size(); ++p) {
+        const int ierr = MPI_Recv_init(
             data.data() + sparsity->row_starts[sparsity->n_locally_owned_dofs] +
-                (p == 0 ? 0 : targets[p - 1].second),
-            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
-                sizeof(Number),
+                (p == 0 ? 0 : receive_targets[p - 1].second),
+            (receive_targets[p].second -
+             (p == 0 ? 0 : receive_targets[p - 1].second)) *
+                sizeof(StorageNumber),
             MPI_BYTE,
-            targets[p].first,
+            receive_targets[p].first,
             mpi_tag,
             sparsity->mpi_communicator,
             &requests[p]);
         AssertThrowMPI(ierr);
       }
+
+      const auto &send_targets = sparsity->send_targets;
+      for (unsigned int p = 0; p < send_targets.size(); ++p) {
+        const int ierr = MPI_Send_init(
+            exchange_buffer.data() +
+                (p == 0 ? 0 : send_targets[p - 1].second),
+            (send_targets[p].second -
+             (p == 0 ? 0 : send_targets[p - 1].second)) *
+                sizeof(StorageNumber),
+            MPI_BYTE,
+            send_targets[p].first,
+            mpi_tag,
+            sparsity->mpi_communicator,
+            &requests[p + receive_targets.size()]);
+        AssertThrowMPI(ierr);
+      }
+
+      persistent_tag = mpi_tag;
     }
+#else
+    (void)communication_channel;
+#endif
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_ghost_rows_start(
+          const unsigned int communication_channel)
+  {
+#ifdef DEAL_II_WITH_MPI
+    setup_requests(communication_channel);
+
+    const std::size_t n_indices = sparsity->indices_to_be_sent.size();
 
     RYUJIN_PARALLEL_REGION_BEGIN
 
@@ -554,27 +746,67 @@ namespace ryujin
 
     RYUJIN_PARALLEL_REGION_END
 
-    {
-      const auto &targets = sparsity->send_targets;
-      for (unsigned int p = 0; p < targets.size(); ++p) {
-        const int ierr = MPI_Isend(
-            exchange_buffer.data() + (p == 0 ? 0 : targets[p - 1].second),
-            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
-                sizeof(Number),
-            MPI_BYTE,
-            targets[p].first,
-            mpi_tag,
-            sparsity->mpi_communicator,
-            &requests[p + sparsity->receive_targets.size()]);
-        AssertThrowMPI(ierr);
-      }
-    }
+    const int ierr = MPI_Startall(requests.size(), requests.data());
+    AssertThrowMPI(ierr);
+#endif
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_ghost_rows_start_receives(const unsigned int communication_channel)
+  {
+#ifdef DEAL_II_WITH_MPI
+    setup_requests(communication_channel);
+
+    const int ierr =
+        MPI_Startall(sparsity->receive_targets.size(), requests.data());
+    AssertThrowMPI(ierr);
+#else
+    (void)communication_channel;
 #endif
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  inline void SparseMatrixSIMD<Number, n_components, simd_length>::
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_ghost_rows_send(const unsigned int target)
+  {
+#ifdef DEAL_II_WITH_MPI
+    const auto &send_targets = sparsity->send_targets;
+    AssertIndexRange(target, send_targets.size());
+    Assert(persistent_tag >= 0,
+           dealii::ExcMessage("update_ghost_rows_start_receives() has to be "
+                              "called first"));
+
+    for (std::size_t c = (target == 0 ? 0 : send_targets[target - 1].second);
+         c < send_targets[target].second;
+         ++c)
+      exchange_buffer[c] = data[sparsity->indices_to_be_sent[c]];
+
+    const int ierr =
+        MPI_Start(&requests[sparsity->receive_targets.size() + target]);
+    AssertThrowMPI(ierr);
+#else
+    (void)target;
+#endif
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
       update_ghost_rows_finish()
   {
 #ifdef DEAL_II_WITH_MPI
@@ -585,9 +817,13 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows()
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_ghost_rows()
   {
     update_ghost_rows_start();
     update_ghost_rows_finish();
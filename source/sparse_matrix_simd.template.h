@@ -11,6 +11,8 @@
 #include <deal.II/base/vectorization.h>
 #include <deal.II/lac/sparse_matrix.h>
 
+#include <algorithm>
+
 namespace ryujin
 {
 
@@ -85,14 +87,70 @@ namespace ryujin
                                    "billion matrix entries per MPI rank. Try to"
                                    " split into smaller problems with MPI"));
 
-    /* Vectorized part: */
+    /* Row starts of the vectorized part: */
 
     row_starts[0] = 0;
 
-    unsigned int *col_ptr = column_indices.data();
-    unsigned int *transposed_ptr = indices_transposed.data();
+    for (unsigned int i = 0; i < n_internal_dofs; i += simd_length) {
+      for (unsigned int k = 1; k < simd_length; ++k)
+        AssertThrow(sparsity.row_length(i + k) == sparsity.row_length(i),
+                    dealii::ExcMessage("All rows of a SIMD row group have to "
+                                       "have the same row length"));
+
+      row_starts[i / simd_length + 1] =
+          row_starts[i / simd_length] + simd_length * sparsity.row_length(i);
+    }
+
+    /* Row starts of the rest: */
+
+    row_starts[n_internal_dofs] = row_starts[n_internal_dofs / simd_length];
+
+    for (unsigned int i = n_internal_dofs; i < sparsity.n_rows(); ++i)
+      row_starts[i + 1] = row_starts[i] + sparsity.row_length(i);
+
+    Assert(row_starts[sparsity.n_rows()] == sparsity.n_nonzero_elements(),
+           dealii::ExcInternalError());
+
+    /*
+     * Populate column indices and transposed indices. We use the same
+     * static row distribution as all compute loops so that memory pages
+     * are first touched by the thread that later works on them:
+     */
+
+    const auto transposed_index = [&](const unsigned int column,
+                                      const unsigned int row) -> unsigned int {
+      const std::size_t position = sparsity(column, row);
+      if (column < n_internal_dofs) {
+        const unsigned int my_row_length = sparsity.row_length(column);
+        const std::size_t position_diag = sparsity(column, column);
+        const std::size_t pos_within_row = position - position_diag;
+        const unsigned int simd_offset = column % simd_length;
+        return position - simd_offset * my_row_length - pos_within_row +
+               simd_offset + pos_within_row * simd_length;
+      }
+      return position;
+    };
+
+    const auto populate_row = [&](const unsigned int i) {
+      unsigned int *col_ptr = column_indices.data() + row_starts[i];
+      unsigned int *transposed_ptr = indices_transposed.data() + row_starts[i];
+      for (auto j = sparsity.begin(i); j != sparsity.end(i); ++j) {
+        const unsigned int column = j->column();
+        *col_ptr++ = column;
+        *transposed_ptr++ = transposed_index(column, i);
+      }
+    };
+
+    const unsigned int n_rows = sparsity.n_rows();
 
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    RYUJIN_OMP_FOR_NOWAIT
     for (unsigned int i = 0; i < n_internal_dofs; i += simd_length) {
+      const auto offset = row_starts[i / simd_length];
+      unsigned int *col_ptr = column_indices.data() + offset;
+      unsigned int *transposed_ptr = indices_transposed.data() + offset;
+
       auto jts = generate_iterators<simd_length>(
           [&](auto k) { return sparsity.begin(i + k); });
 
@@ -100,46 +158,19 @@ namespace ryujin
         for (unsigned int k = 0; k < simd_length; ++k) {
           const unsigned int column = jts[k]->column();
           *col_ptr++ = column;
-          const std::size_t position = sparsity(column, i + k);
-          if (column < n_internal_dofs) {
-            const unsigned int my_row_length = sparsity.row_length(column);
-            const std::size_t position_diag = sparsity(column, column);
-            const std::size_t pos_within_row = position - position_diag;
-            const unsigned int simd_offset = column % simd_length;
-            *transposed_ptr++ = position - simd_offset * my_row_length -
-                                pos_within_row + simd_offset +
-                                pos_within_row * simd_length;
-          } else
-            *transposed_ptr++ = position;
+          *transposed_ptr++ = transposed_index(column, i + k);
         }
-
-      row_starts[i / simd_length + 1] = col_ptr - column_indices.data();
     }
 
-    /* Rest: */
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = n_internal_dofs; i < n_locally_owned_dofs; ++i)
+      populate_row(i);
 
-    row_starts[n_internal_dofs] = row_starts[n_internal_dofs / simd_length];
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = n_locally_owned_dofs; i < n_rows; ++i)
+      populate_row(i);
 
-    for (unsigned int i = n_internal_dofs; i < sparsity.n_rows(); ++i) {
-      for (auto j = sparsity.begin(i); j != sparsity.end(i); ++j) {
-        const unsigned int column = j->column();
-        *col_ptr++ = column;
-        const std::size_t position = sparsity(column, i);
-        if (column < n_internal_dofs) {
-          const unsigned int my_row_length = sparsity.row_length(column);
-          const std::size_t position_diag = sparsity(column, column);
-          const std::size_t pos_within_row = position - position_diag;
-          const unsigned int simd_offset = column % simd_length;
-          *transposed_ptr++ = position - simd_offset * my_row_length -
-                              pos_within_row + simd_offset +
-                              pos_within_row * simd_length;
-        } else
-          *transposed_ptr++ = position;
-      }
-      row_starts[i + 1] = col_ptr - column_indices.data();
-    }
-
-    Assert(col_ptr == column_indices.end(), dealii::ExcInternalError());
+    RYUJIN_PARALLEL_REGION_END
 
     /* Compute the data exchange pattern: */
 
@@ -234,33 +265,115 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  SparseMatrixSIMD<Number, n_components, simd_length>::SparseMatrixSIMD()
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      SparseMatrixSIMD()
       : sparsity(nullptr)
+      , persistent_tag(-1)
   {
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  SparseMatrixSIMD<Number, n_components, simd_length>::SparseMatrixSIMD(
-      const SparsityPatternSIMD<simd_length> &sparsity)
-      : sparsity(&sparsity)
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      SparseMatrixSIMD(const SparsityPatternSIMD<simd_length> &sparsity)
+      : sparsity(nullptr)
+      , persistent_tag(-1)
   {
-    data.resize(sparsity.n_nonzero_elements() * n_components);
+    reinit(sparsity);
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  void SparseMatrixSIMD<Number, n_components, simd_length>::reinit(
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      ~SparseMatrixSIMD()
+  {
+    free_requests();
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      free_requests()
+  {
+#ifdef DEAL_II_WITH_MPI
+    for (auto &request : requests)
+      if (request != MPI_REQUEST_NULL)
+        MPI_Request_free(&request);
+#endif
+    requests.clear();
+    persistent_tag = -1;
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::reinit(
       const SparsityPatternSIMD<simd_length> &sparsity)
   {
+    /* Persistent MPI requests refer to the old storage: */
+    free_requests();
+
     this->sparsity = &sparsity;
-    data.resize(sparsity.n_nonzero_elements() * n_components);
+    data.resize_fast(sparsity.n_nonzero_elements() * n_components);
+
+    /*
+     * Zero out the matrix with the same static row distribution that is
+     * used in all compute loops. This way every memory page is first
+     * touched (and thus placed) by the thread that later works on it.
+     */
+
+    const auto &row_starts = sparsity.row_starts;
+    const unsigned int n_internal_dofs = sparsity.n_internal_dofs;
+    const unsigned int n_locally_owned_dofs = sparsity.n_locally_owned_dofs;
+    const unsigned int n_rows = sparsity.n_rows();
+    StorageNumber *ptr = data.data();
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = 0; i < n_internal_dofs; i += simd_length)
+      std::fill(ptr + row_starts[i / simd_length] * n_components,
+                ptr + row_starts[i / simd_length + 1] * n_components,
+                StorageNumber(0.));
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = n_internal_dofs; i < n_locally_owned_dofs; ++i)
+      std::fill(ptr + row_starts[i] * n_components,
+                ptr + row_starts[i + 1] * n_components,
+                StorageNumber(0.));
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = n_locally_owned_dofs; i < n_rows; ++i)
+      std::fill(ptr + row_starts[i] * n_components,
+                ptr + row_starts[i + 1] * n_components,
+                StorageNumber(0.));
+
+    RYUJIN_PARALLEL_REGION_END
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  void SparseMatrixSIMD<Number, n_components, simd_length>::read_in(
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::read_in(
       const std::array<dealii::SparseMatrix<Number>, n_components>
           &sparse_matrix)
   {
@@ -310,8 +423,12 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  void SparseMatrixSIMD<Number, n_components, simd_length>::read_in(
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::read_in(
       const dealii::SparseMatrix<Number> &sparse_matrix)
   {
     RYUJIN_PARALLEL_REGION_BEGIN
@@ -8,6 +8,7 @@
 
 #include <compile_time_options.h>
 
+#include "checkpointing.h"
 #include "discretization.h"
 #include "initial_values.h"
 #include "offline_data.h"
@@ -68,7 +69,9 @@ namespace ryujin
 
     void print_parameters(std::ostream &stream);
     void print_mpi_partition(std::ostream &stream);
+    void print_numa_placement(const vector_type &U, std::ostream &stream);
     void print_memory_statistics(std::ostream &stream);
+    void print_compression_statistics(std::ostream &stream);
     void print_timers(std::ostream &stream);
     void print_throughput(unsigned int cycle, Number t, std::ostream &stream);
 
@@ -98,13 +101,22 @@ namespace ryujin
     Number output_granularity;
 
     bool enable_checkpointing;
+    std::string checkpoint_format;
+    std::string checkpoint_compression;
     bool enable_output_full;
     bool enable_output_cutplanes;
+    bool enable_output_raw;
     bool enable_compute_error;
 
     unsigned int output_checkpoint_multiplier;
     unsigned int output_full_multiplier;
     unsigned int output_cutplanes_multiplier;
+    unsigned int output_raw_multiplier;
+
+    std::string output_raw_compression;
+    double output_raw_tolerance;
+
+    unsigned int io_aggregators;
 
     bool resume;
 
@@ -126,6 +138,9 @@ namespace ryujin
     ryujin::EulerModule<dim, Number> euler_module;
     ryujin::Postprocessor<dim, Number> postprocessor;
 
+    ryujin::CheckpointWriter checkpoint_writer;
+    ryujin::CompressionStatistics compression_statistics;
+
     const unsigned int mpi_rank;
     const unsigned int n_mpi_processes;
 
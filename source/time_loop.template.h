@@ -6,9 +6,9 @@
 #ifndef TIME_LOOP_TEMPLATE_H
 #define TIME_LOOP_TEMPLATE_H
 
-#include "checkpointing.h"
 #include "indicator.h"
 #include "limiter.h"
+#include "numa.h"
 #include "riemann_solver.h"
 #include "scope.h"
 #include "time_loop.h"
@@ -72,6 +72,26 @@ namespace ryujin
         "at output granularity intervals. The frequency is determined by "
         "\"output granularity\" times \"output checkpoint multiplier\"");
 
+    checkpoint_format = "bulk";
+    add_parameter(
+        "checkpoint format",
+        checkpoint_format,
+        "Format of checkpoints. Valid choices are \"bulk\" (one raw binary "
+        "file per MPI rank written asynchronously, requires the same number "
+        "of MPI ranks for resume), \"shared\" (a single file written with "
+        "collective MPI-IO, requires the same number of MPI ranks for "
+        "resume), and \"repartitionable\" (solution stored along with the "
+        "p4est forest, can be resumed with an arbitrary number of MPI "
+        "ranks)");
+
+    checkpoint_compression = "none";
+    add_parameter(
+        "checkpoint compression",
+        checkpoint_compression,
+        "Lossless compression applied to bulk and shared checkpoints. Valid "
+        "choices are \"none\" and \"xor shuffle\" (XOR delta of "
+        "consecutive values, byte shuffle and zero run-length encoding)");
+
     enable_output_full = true;
     add_parameter("enable output full",
                   enable_output_full,
@@ -85,6 +105,14 @@ namespace ryujin
         "Write out cutplanes pvtu records. The frequency is determined by "
         "\"output granularity\" times \"output cutplanes multiplier\"");
 
+    enable_output_raw = false;
+    add_parameter(
+        "enable output raw",
+        enable_output_raw,
+        "Write out the raw state vector into a single shared binary file "
+        "with collective MPI-IO. The frequency is determined by "
+        "\"output granularity\" times \"output raw multiplier\"");
+
     output_checkpoint_multiplier = 1;
     add_parameter("output checkpoint multiplier",
                   output_checkpoint_multiplier,
@@ -103,6 +131,35 @@ namespace ryujin
                   "Multiplicative modifier applied to \"output granularity\" "
                   "that determines the cutplanes pvtu writeout granularity");
 
+    output_raw_multiplier = 1;
+    add_parameter("output raw multiplier",
+                  output_raw_multiplier,
+                  "Multiplicative modifier applied to \"output granularity\" "
+                  "that determines the raw output granularity");
+
+    output_raw_compression = "none";
+    add_parameter("output raw compression",
+                  output_raw_compression,
+                  "Compression applied to raw output. Valid choices are "
+                  "\"none\", \"xor shuffle\" (lossless), and \"quantize\" "
+                  "(lossy with an absolute error bounded by \"output raw "
+                  "tolerance\")");
+
+    output_raw_tolerance = 1.e-6;
+    add_parameter("output raw tolerance",
+                  output_raw_tolerance,
+                  "Maximal absolute quantization error of the \"quantize\" "
+                  "raw output compression. The stored values additionally "
+                  "carry the rounding error of the floating point type");
+
+    io_aggregators = 0;
+    add_parameter("io aggregators",
+                  io_aggregators,
+                  "Number of aggregators used for collective buffering in "
+                  "shared checkpoints and raw output (MPI-IO \"cb_nodes\" "
+                  "hint). Set to 0 in order to use the default of the MPI "
+                  "implementation");
+
     enable_compute_error = false;
     add_parameter("enable compute error",
                   enable_compute_error,
@@ -131,8 +188,23 @@ namespace ryujin
     AssertThrow(!enable_checkpointing || !enable_compute_error,
                 ExcNotImplemented());
 
-    const bool write_output_files =
-        enable_checkpointing || enable_output_full || enable_output_cutplanes;
+    AssertThrow(checkpoint_format == "bulk" || checkpoint_format == "shared" ||
+                    checkpoint_format == "repartitionable",
+                ExcMessage("Unknown checkpoint format."));
+
+    const auto checkpoint_codec = codec_from_string(checkpoint_compression);
+    AssertThrow(checkpoint_codec != Codec::quantize,
+                ExcMessage("Checkpoints require a lossless compression."));
+    AssertThrow(checkpoint_codec == Codec::none ||
+                    checkpoint_format != "repartitionable",
+                ExcMessage("Repartitionable checkpoints cannot be "
+                           "compressed."));
+    codec_from_string(output_raw_compression);
+
+    const bool write_output_files = enable_checkpointing ||
+                                    enable_output_full ||
+                                    enable_output_cutplanes ||
+                                    enable_output_raw;
 
     /* Attach log file: */
     logfile.open(base_name + ".log");
@@ -149,25 +221,45 @@ namespace ryujin
       Scope scope(computing_timer, "initialize data structures");
       print_info("initializing data structures");
 
-      discretization.prepare();
+      if (resume && checkpoint_format == "repartitionable")
+        discretization.prepare(repartitionable_checkpoint_name(base_name));
+      else
+        discretization.prepare();
       offline_data.prepare();
       euler_module.prepare();
       postprocessor.prepare();
 
       print_mpi_partition(logfile);
 
-      U.reinit(offline_data.vector_partitioner());
+      reinit_first_touch(U,
+                         offline_data.vector_partitioner(),
+                         offline_data.n_locally_internal(),
+                         offline_data.n_locally_owned());
 
       if (resume) {
         print_info("resuming interrupted computation");
-        const auto id =
-            discretization.triangulation().locally_owned_subdomain();
-        do_resume(base_name, id, U, t, output_cycle);
+        if (checkpoint_format == "repartitionable") {
+          do_resume_repartitionable<dim>(base_name,
+                                         offline_data.dof_handler(),
+                                         offline_data.scalar_partitioner(),
+                                         U,
+                                         t,
+                                         output_cycle);
+        } else if (checkpoint_format == "shared") {
+          do_resume_shared<dim>(
+              shared_checkpoint_name(base_name), U, t, output_cycle);
+        } else {
+          const auto id =
+              discretization.triangulation().locally_owned_subdomain();
+          do_resume<dim>(base_name, id, U, t, output_cycle);
+        }
         t_initial = t;
       } else {
         print_info("interpolating initial values");
         U = initial_values.interpolate(offline_data);
       }
+
+      print_numa_placement(U, logfile);
     }
 
     if (write_output_files) {
@@ -214,8 +306,11 @@ namespace ryujin
         print_cycle_statistics(cycle, t, output_cycle);
     } /* end of loop */
 
-    /* Wait for output thread: */
+    /* Wait for output and checkpointing threads: */
     postprocessor.wait();
+    const auto statistics = checkpoint_writer.wait();
+    if (statistics.uncompressed_size > 0)
+      compression_statistics = statistics;
 
     /* We have actually performed one cycle less. */
     --cycle;
@@ -387,14 +482,65 @@ namespace ryujin
                                     do_cutplanes);
     }
 
+    /* Raw output: */
+
+    if (cycle % output_raw_multiplier == 0 && enable_output_raw) {
+      print_info("writing raw output");
+      Scope scope(computing_timer, "raw output");
+      const auto statistics = write_shared_snapshot<dim>(
+          name + "-raw_" + Utilities::to_string(cycle, 6) + ".bin",
+          U,
+          t,
+          cycle,
+          io_aggregators,
+          codec_from_string(output_raw_compression),
+          output_raw_tolerance);
+      if (statistics.uncompressed_size > 0)
+        compression_statistics = statistics;
+    }
+
     /* Checkpointing: */
 
     if (cycle % output_checkpoint_multiplier == 0 && enable_checkpointing) {
 
+      {
+        /* Wait for a previous checkpoint to finish: */
+        Scope scope(computing_timer, "output stall");
+        if (checkpoint_writer.is_active())
+          print_info("waiting for previous checkpoint to finish");
+
+        const auto statistics = checkpoint_writer.wait();
+        if (statistics.uncompressed_size > 0)
+          compression_statistics = statistics;
+      }
+
+      const auto codec = codec_from_string(checkpoint_compression);
+
       print_info("scheduling checkpointing");
       Scope scope(computing_timer, "checkpointing");
-      const auto id = discretization.triangulation().locally_owned_subdomain();
-      do_checkpoint(base_name, id, U, t, cycle);
+      if (checkpoint_format == "repartitionable") {
+        do_checkpoint_repartitionable<dim>(base_name,
+                                           offline_data.dof_handler(),
+                                           offline_data.scalar_partitioner(),
+                                           U,
+                                           t,
+                                           cycle);
+      } else if (checkpoint_format == "shared") {
+        const auto statistics =
+            write_shared_snapshot<dim>(shared_checkpoint_name(base_name),
+                                       U,
+                                       t,
+                                       cycle,
+                                       io_aggregators,
+                                       codec);
+        if (statistics.uncompressed_size > 0)
+          compression_statistics = statistics;
+      } else {
+        const auto id =
+            discretization.triangulation().locally_owned_subdomain();
+        checkpoint_writer.schedule_checkpoint<dim>(
+            base_name, id, U, t, cycle, codec);
+      }
     }
   }
 
@@ -545,6 +691,15 @@ namespace ryujin
     case EulerModule<dim, Number>::TimeStepOrder::third_order:
       stream << "EulerModule<dim, Number>::TimeStepOrder::third_order" << std::endl;
       break;
+    case EulerModule<dim, Number>::TimeStepOrder::third_order_four_stages:
+      stream << "EulerModule<dim, Number>::TimeStepOrder::third_order_four_stages" << std::endl;
+      break;
+    case EulerModule<dim, Number>::TimeStepOrder::third_order_five_stages:
+      stream << "EulerModule<dim, Number>::TimeStepOrder::third_order_five_stages" << std::endl;
+      break;
+    case EulerModule<dim, Number>::TimeStepOrder::fourth_order_ten_stages:
+      stream << "EulerModule<dim, Number>::TimeStepOrder::fourth_order_ten_stages" << std::endl;
+      break;
     }
 
     stream << "EulerModule<dim, Number>::limiter_iter_ == "
@@ -611,6 +766,60 @@ namespace ryujin
   }
 
 
+  template <int dim, typename Number>
+  void TimeLoop<dim, Number>::print_numa_placement(const vector_type &U,
+                                                   std::ostream &stream)
+  {
+    /*
+     * Thread binding and page placement are local properties of every
+     * MPI rank. We only report them for rank 0:
+     */
+
+    const auto binding = thread_binding();
+    const auto threads = thread_placement();
+
+    const auto &partitioner = *U.get_partitioner();
+    const auto pages_U = page_placement(
+        U.begin(),
+        (partitioner.local_size() + partitioner.n_ghost_indices()) *
+            sizeof(Number));
+
+    std::vector<std::pair<std::string, std::vector<std::size_t>>> pages{
+        {"sparsity pattern",
+         offline_data.sparsity_pattern_simd().page_placement()},
+        {"mass matrix", offline_data.mass_matrix().page_placement()},
+        {"beta_ij matrix", offline_data.betaij_matrix().page_placement()},
+        {"c_ij matrix", offline_data.cij_matrix().page_placement()},
+        {"d_ij matrix", euler_module.dij_matrix().page_placement()},
+        {"state vector U", pages_U}};
+
+    if (mpi_rank != 0)
+      return;
+
+    if (binding == "false")
+      print_info("warning: OpenMP threads are not bound to cores. Set "
+                 "OMP_PROC_BIND and OMP_PLACES for NUMA aware memory "
+                 "placement.");
+
+    stream << std::endl << "NUMA placement (rank 0):" << std::endl << std::endl;
+
+    stream << "Thread binding (OMP_PROC_BIND): " << binding << std::endl;
+    for (unsigned int t = 0; t < threads.size(); ++t)
+      stream << "    Thread " << t << ":\tcpu " << threads[t].first
+             << ",\tnode " << threads[t].second << std::endl;
+
+    stream << "Memory pages per NUMA node:" << std::endl;
+    for (const auto &[name, placement] : pages) {
+      stream << "    " << std::setw(18) << std::left << name << std::right;
+      if (placement.empty())
+        stream << "  (not available)";
+      for (unsigned int node = 0; node < placement.size(); ++node)
+        stream << "  [" << node << "] " << std::setw(9) << placement[node];
+      stream << std::endl;
+    }
+  }
+
+
   template <int dim, typename Number>
   void TimeLoop<dim, Number>::print_memory_statistics(std::ostream &stream)
   {
@@ -638,6 +847,32 @@ namespace ryujin
   }
 
 
+  template <int dim, typename Number>
+  void TimeLoop<dim, Number>::print_compression_statistics(
+      std::ostream &stream)
+  {
+    std::ostringstream output;
+
+    const auto uncompressed_size = Utilities::MPI::sum(
+        compression_statistics.uncompressed_size, mpi_communicator);
+    const auto compressed_size = Utilities::MPI::sum(
+        compression_statistics.compressed_size, mpi_communicator);
+    const double seconds =
+        Utilities::MPI::max(compression_statistics.seconds, mpi_communicator);
+
+    if (mpi_rank != 0 || uncompressed_size == 0)
+      return;
+
+    output << "Compression: (last snapshot)  ratio " << std::setprecision(2)
+           << std::fixed << double(uncompressed_size) / compressed_size
+           << "  (" << std::setprecision(1)
+           << (seconds > 0. ? uncompressed_size / seconds / 1.e6 : 0.)
+           << " MB/s)";
+
+    stream << output.str() << std::endl;
+  }
+
+
   template <int dim, typename Number>
   void TimeLoop<dim, Number>::print_timers(std::ostream &stream)
   {
@@ -763,9 +998,76 @@ namespace ryujin
            << std::setprecision(0) << std::fixed << euler_module.n_restarts() //
            << " rsts   (" << std::setprecision(2) << std::scientific
            << euler_module.n_restarts() / ((double)cycle) << " rsts/cycle) ]"
+           << std::endl;
+
+    const double wasted_time =
+        Utilities::MPI::max(euler_module.wasted_time(), mpi_communicator);
+
+    output << "                     [ "                                       //
+           << euler_module.n_wasted_stages() << " wasted stages   ("          //
+           << std::setprecision(2) << std::scientific << wasted_time          //
+           << "s, " << std::setprecision(1) << std::fixed                     //
+           << 100. * wasted_time / wall_time << "%)   (tau factor "           //
+           << std::setprecision(3) << euler_module.tau_factor() << ") ]"      //
+           << std::endl;
+    output << "                     [ "                                       //
+           << std::setprecision(4) << std::scientific                         //
+           << (t - t_initial) / wall_time << " simulated time per second ]"   //
            << std::endl
            << std::endl;
 
+    /*
+     * Print the per-thread busy and idle times of the parallel regions
+     * of euler_step() (minimum, average, and maximum over all threads
+     * and MPI ranks):
+     */
+
+    output << "Load balance:  (thread busy time min / avg / max, idle time)"
+           << std::endl;
+
+    const auto &load_balance_statistics =
+        euler_module.load_balance_statistics();
+
+    for (unsigned int k = 0; k < load_balance_statistics.size(); ++k) {
+      const auto &statistics = load_balance_statistics[k];
+      const unsigned int n_threads = statistics.n_threads();
+
+      double busy_min = std::numeric_limits<double>::max();
+      double busy_max = 0.;
+      double busy_sum = 0.;
+      double idle_sum = 0.;
+      for (unsigned int thread = 0; thread < n_threads; ++thread) {
+        busy_min = std::min(busy_min, statistics.busy(thread));
+        busy_max = std::max(busy_max, statistics.busy(thread));
+        busy_sum += statistics.busy(thread);
+        idle_sum += statistics.idle(thread);
+      }
+
+      busy_min = Utilities::MPI::min(busy_min, mpi_communicator);
+      busy_max = Utilities::MPI::max(busy_max, mpi_communicator);
+      const double busy_avg =
+          Utilities::MPI::min_max_avg(busy_sum / n_threads, mpi_communicator)
+              .avg;
+      const double idle_avg =
+          Utilities::MPI::min_max_avg(idle_sum / n_threads, mpi_communicator)
+              .avg;
+
+      /* The last entry accumulates all high-order passes: */
+      const std::string label =
+          std::to_string(k) +
+          (k + 1 == load_balance_statistics.size() ? "+" : " ");
+      const double total = busy_avg + idle_avg;
+
+      output << "    [step " << label << "]  " << std::setprecision(2)
+             << std::scientific << busy_min << "s / " << busy_avg << "s / "
+             << busy_max << "s   " << idle_avg << "s ("
+             << std::setprecision(1) << std::fixed
+             << (total > 0. ? 100. * idle_avg / total : 0.) << "%)"
+             << std::endl;
+    }
+
+    output << std::endl;
+
     /* and print an ETA */
     unsigned int eta =
         static_cast<unsigned int>((t_final - t) / (t - t_initial) * wall_time);
@@ -845,7 +1147,8 @@ namespace ryujin
     std::ostringstream output;
 
     unsigned int n_active_writebacks = Utilities::MPI::sum<unsigned int>(
-        postprocessor.is_active(), mpi_communicator);
+        postprocessor.is_active() || checkpoint_writer.is_active(),
+        mpi_communicator);
 
     std::ostringstream primary;
     if (final_time) {
@@ -875,6 +1178,7 @@ namespace ryujin
              << " ranks performing output !!!" << std::flush;
 
     print_memory_statistics(output);
+    print_compression_statistics(output);
     print_timers(output);
     print_throughput(cycle, t, output);
 
@@ -0,0 +1,58 @@
+#include <boundary_table.h>
+
+#include <map>
+#include <tuple>
+
+using namespace ryujin;
+
+int main()
+{
+  /*
+   * Boundary indices 3, 64, 65, 66, 130 out of 150 locally relevant
+   * indices. Indices 64 and 65 are at the start of the second word of
+   * the bitmap:
+   */
+  std::map<unsigned int,
+           std::tuple<dealii::Tensor<1, 2, double>,
+                      dealii::types::boundary_id,
+                      dealii::Point<2>>>
+      boundary_map;
+
+  const auto add = [&](unsigned int i, double nx, double ny, auto id) {
+    dealii::Tensor<1, 2, double> normal;
+    normal[0] = nx;
+    normal[1] = ny;
+    boundary_map[i] = std::make_tuple(
+        normal, dealii::types::boundary_id(id), dealii::Point<2>(i, -1. * i));
+  };
+
+  add(3, 1., 0., Boundary::slip);
+  add(64, 0., 1., Boundary::slip);
+  add(65, 0., -1., Boundary::slip);
+  add(66, 1., 0., Boundary::dirichlet);
+  add(130, 0., 1., Boundary::do_nothing);
+
+  BoundaryTable<2, double> boundary_table;
+  boundary_table.reinit(150, boundary_map);
+
+  std::cout << "Number of boundary dofs: " << boundary_table.n_boundary_dofs()
+            << std::endl;
+
+  std::cout << "Boundary indices and slots" << std::endl;
+  for (unsigned int i = 0; i < 150; ++i)
+    if (boundary_table.is_boundary(i))
+      std::cout << i << " -> " << boundary_table.slot(i) << std::endl;
+
+  std::cout << "Slots" << std::endl;
+  for (unsigned int k = 0; k < boundary_table.n_boundary_dofs(); ++k)
+    std::cout << boundary_table.index(k) << " "
+              << (unsigned int)boundary_table.id(k) << " "
+              << boundary_table.normal(k) << " "
+              << boundary_table.position(k) << std::endl;
+
+  std::cout << "Vectorized normals" << std::endl;
+  const auto normal = boundary_table.get_vectorized_normal<
+      dealii::VectorizedArray<double, 2>>(boundary_table.slot(64));
+  for (unsigned int k = 0; k < 2; ++k)
+    std::cout << normal[0][k] << " " << normal[1][k] << std::endl;
+}
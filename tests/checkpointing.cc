@@ -0,0 +1,199 @@
+#include <checkpointing.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <cmath>
+#include <iostream>
+
+using namespace ryujin;
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  dealii::IndexSet locally_owned(10);
+  locally_owned.add_range(0, 10);
+  const auto scalar_partitioner =
+      std::make_shared<const dealii::Utilities::MPI::Partitioner>(
+          locally_owned, MPI_COMM_SELF);
+
+  MultiComponentVector<double, 3> U;
+  U.reinit_with_scalar_partitioner(scalar_partitioner);
+  for (unsigned int i = 0; i < U.local_size(); ++i)
+    U.local_element(i) = 0.5 * i;
+
+  do_checkpoint<1>("checkpointing", 0, U, 0.25, 7);
+
+  MultiComponentVector<double, 3> V;
+  V.reinit_with_scalar_partitioner(scalar_partitioner);
+  double t = 0.;
+  unsigned int output_cycle = 0;
+  do_resume<1>("checkpointing", 0, V, t, output_cycle);
+
+  std::cout << "t = " << t << ", output cycle = " << output_cycle
+            << std::endl;
+
+  bool equal = true;
+  for (unsigned int i = 0; i < U.local_size(); ++i)
+    equal = equal && (V.local_element(i) == U.local_element(i));
+  std::cout << "payload " << (equal ? "matches" : "differs") << std::endl;
+
+  /* Asynchronous write-out: */
+  {
+    CheckpointWriter checkpoint_writer;
+    checkpoint_writer.schedule_checkpoint<1>("checkpointing", 0, U, 0.5, 8);
+    /* The snapshot is taken synchronously: */
+    U.local_element(0) = -1.;
+    checkpoint_writer.wait();
+  }
+
+  do_resume<1>("checkpointing", 0, V, t, output_cycle);
+  std::cout << "t = " << t << ", output cycle = " << output_cycle
+            << ", U_0 = " << V.local_element(0) << std::endl;
+
+  /* A checkpoint written for dim = 1 must not be accepted for dim = 2: */
+  try {
+    do_resume<2>("checkpointing", 0, V, t, output_cycle);
+    std::cout << "configuration mismatch not detected" << std::endl;
+  } catch (const dealii::ExceptionBase &) {
+    std::cout << "configuration mismatch detected" << std::endl;
+  }
+
+  /* Corrupt a single byte of the payload: */
+  {
+    std::fstream file(checkpoint_name("checkpointing", 0),
+                      std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(CheckpointHeader) + 3);
+    file.put(char(0x5a));
+  }
+
+  try {
+    do_resume<1>("checkpointing", 0, V, t, output_cycle);
+    std::cout << "checksum mismatch not detected" << std::endl;
+  } catch (const dealii::ExceptionBase &) {
+    std::cout << "checksum mismatch detected" << std::endl;
+  }
+
+  /* Compressed checkpoint of a smooth field: */
+  {
+    dealii::IndexSet locally_owned(1000);
+    locally_owned.add_range(0, 1000);
+    const auto scalar_partitioner =
+        std::make_shared<const dealii::Utilities::MPI::Partitioner>(
+            locally_owned, MPI_COMM_SELF);
+
+    MultiComponentVector<double, 3> W;
+    W.reinit_with_scalar_partitioner(scalar_partitioner);
+    for (unsigned int i = 0; i < W.local_size(); ++i)
+      W.local_element(i) = std::cos(1.e-2 * i);
+
+    do_checkpoint<1>("checkpointing", 0, W, 0.25, 7, Codec::xor_shuffle);
+
+    MultiComponentVector<double, 3> X;
+    X.reinit_with_scalar_partitioner(scalar_partitioner);
+    do_resume<1>("checkpointing", 0, X, t, output_cycle);
+
+    equal = true;
+    for (unsigned int i = 0; i < W.local_size(); ++i)
+      equal = equal && (X.local_element(i) == W.local_element(i));
+    std::cout << "compressed: t = " << t << ", output cycle = "
+              << output_cycle << ", payload "
+              << (equal ? "matches" : "differs") << std::endl;
+  }
+
+  /* Shared checkpoint written with collective MPI-IO: */
+  {
+    const auto name = shared_checkpoint_name("checkpointing");
+
+    for (const auto codec : {Codec::xor_shuffle, Codec::none}) {
+      write_shared_snapshot<1>(name, U, 0.75, 11, 0, codec);
+
+      V = 0.;
+      do_resume_shared<1>(name, V, t, output_cycle);
+
+      equal = true;
+      for (unsigned int i = 0; i < U.local_size(); ++i)
+        equal = equal && (V.local_element(i) == U.local_element(i));
+      std::cout << "shared (" << (codec == Codec::none ? "none" : "xor")
+                << "): t = " << t << ", output cycle = " << output_cycle
+                << ", payload " << (equal ? "matches" : "differs")
+                << std::endl;
+    }
+
+    /* Corrupt a single byte of the (uncompressed) slice of rank 0: */
+    {
+      std::fstream file(name, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(sizeof(CheckpointHeader) + 3 * sizeof(std::uint64_t) + 3);
+      file.put(char(0x5a));
+    }
+
+    try {
+      do_resume_shared<1>(name, V, t, output_cycle);
+      std::cout << "shared: checksum mismatch not detected" << std::endl;
+    } catch (const dealii::ExceptionBase &) {
+      std::cout << "shared: checksum mismatch detected" << std::endl;
+    }
+  }
+
+  /*
+   * Repartitionable checkpoint: Write two generations and resume from
+   * the latest one on a freshly loaded mesh:
+   */
+  {
+    const auto setup = [](auto &triangulation, auto &dof_handler) {
+      static const dealii::FE_Q<2> fe(1);
+      dof_handler.initialize(triangulation, fe);
+      return std::make_shared<const dealii::Utilities::MPI::Partitioner>(
+          dof_handler.locally_owned_dofs(), MPI_COMM_SELF);
+    };
+
+    dealii::parallel::distributed::Triangulation<2> triangulation(
+        MPI_COMM_SELF);
+    dealii::GridGenerator::hyper_cube(triangulation);
+    triangulation.refine_global(2);
+    dealii::DoFHandler<2> dof_handler;
+    const auto partitioner = setup(triangulation, dof_handler);
+
+    MultiComponentVector<double, 3> W;
+    W.reinit_with_scalar_partitioner(partitioner);
+    for (unsigned int i = 0; i < W.local_size(); ++i)
+      W.local_element(i) = 0.25 * i;
+
+    do_checkpoint_repartitionable<2>(
+        "checkpointing", dof_handler, partitioner, W, 1.0, 9);
+    W.local_element(0) = 42.;
+    do_checkpoint_repartitionable<2>(
+        "checkpointing", dof_handler, partitioner, W, 1.5, 10);
+
+    dealii::parallel::distributed::Triangulation<2> loaded_triangulation(
+        MPI_COMM_SELF);
+    loaded_triangulation.load(repartitionable_checkpoint_name("checkpointing"));
+    dealii::DoFHandler<2> loaded_dof_handler;
+    const auto loaded_partitioner =
+        setup(loaded_triangulation, loaded_dof_handler);
+
+    MultiComponentVector<double, 3> X;
+    X.reinit_with_scalar_partitioner(loaded_partitioner);
+    do_resume_repartitionable<2>("checkpointing",
+                                 loaded_dof_handler,
+                                 loaded_partitioner,
+                                 X,
+                                 t,
+                                 output_cycle);
+
+    std::cout << "repartitionable: t = " << t
+              << ", output cycle = " << output_cycle << std::endl;
+
+    equal = X.local_size() == W.local_size();
+    for (unsigned int i = 0; equal && i < W.local_size(); ++i)
+      equal = X.local_element(i) == W.local_element(i);
+    std::cout << "repartitionable: payload "
+              << (equal ? "matches" : "differs") << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include <compression.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using namespace ryujin;
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  /* A smooth field with three components spanning several blocks: */
+  constexpr unsigned int n_comp = 3;
+  const std::size_t n = 300000 * n_comp;
+  std::vector<double> values(n);
+  for (std::size_t i = 0; i < n; ++i)
+    values[i] = (i % n_comp + 1.) + std::sin(1.e-4 * (i / n_comp));
+
+  /* Lossless round trip: */
+  {
+    const auto compressed =
+        compress(Codec::xor_shuffle, values.data(), n, n_comp, 0., 4);
+    std::vector<double> result(n);
+    decompress(compressed.data(), compressed.size(), result.data(), n, 4);
+    std::cout << "xor shuffle: round trip "
+              << (result == values ? "exact" : "differs") << ", "
+              << (compressed.size() < n * sizeof(double) ? "smaller"
+                                                         : "not smaller")
+              << std::endl;
+  }
+
+  /* Bounded-error round trip: */
+  {
+    const double tolerance = 1.e-6;
+    const auto compressed =
+        compress(Codec::quantize, values.data(), n, n_comp, tolerance, 4);
+    std::vector<double> result(n);
+    decompress(compressed.data(), compressed.size(), result.data(), n, 4);
+    /* The result carries an additional rounding error: */
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+    bool within = true;
+    for (std::size_t i = 0; i < n; ++i)
+      within = within && std::abs(result[i] - values[i]) <=
+                             tolerance + eps * std::abs(values[i]);
+    std::cout << "quantize: error " << (within ? "within" : "exceeds")
+              << " tolerance" << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include <compile_time_options.h>
+
+#include <discretization.h>
+#include <euler_module.h>
+#include <initial_values.h>
+#include <offline_data.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parameter_acceptor.h>
+
+#include <iostream>
+#include <sstream>
+
+using namespace ryujin;
+
+/*
+ * Run a few time steps on more than one MPI rank. Every rank has ghost
+ * row blocks, which Step 0 has to mark as completed for Step 1 as well.
+ * Otherwise, the dataflow execution of Step 0 to Step 2 never finishes.
+ *
+ * The result of fine row blocks with temporal blocking (Phase A and B)
+ * is compared against a run with a single row block per thread and
+ * stage-by-stage execution. Every row is computed by the same sequence
+ * of operations in both runs, thus a missing block dependency or a race
+ * between Phase A and B shows up as a difference.
+ */
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  const MPI_Comm mpi_communicator = MPI_COMM_WORLD;
+  std::map<std::string, dealii::Timer> computing_timer;
+
+  Discretization<DIM> discretization(mpi_communicator, "/B - Discretization");
+  OfflineData<DIM, NUMBER> offline_data(
+      mpi_communicator, discretization, "/C - OfflineData");
+  InitialValues<DIM, NUMBER> initial_values("/D - InitialValues");
+  EulerModule<DIM, NUMBER> euler_module(mpi_communicator,
+                                        computing_timer,
+                                        offline_data,
+                                        initial_values,
+                                        "/E - EulerModule");
+  EulerModule<DIM, NUMBER> reference_module(mpi_communicator,
+                                            computing_timer,
+                                            offline_data,
+                                            initial_values,
+                                            "/F - EulerModule reference");
+
+  std::istringstream parameters("subsection B - Discretization\n"
+                                "  set mesh refinement = 2\n"
+                                "end\n"
+                                "subsection E - EulerModule\n"
+                                "  set scheduling chunks per thread = 8\n"
+                                "  set temporal blocking = true\n"
+                                "end\n"
+                                "subsection F - EulerModule reference\n"
+                                "  set scheduling chunks per thread = 1\n"
+                                "  set temporal blocking = false\n"
+                                "  set early halo sends = false\n"
+                                "end\n");
+  dealii::ParameterAcceptor::initialize(parameters);
+
+  discretization.prepare();
+  offline_data.prepare();
+  euler_module.prepare();
+  reference_module.prepare();
+
+  auto U = initial_values.interpolate(offline_data);
+  auto U_reference = initial_values.interpolate(offline_data);
+
+  NUMBER t = 0.;
+  NUMBER t_reference = 0.;
+  constexpr unsigned int n_steps = 5;
+  for (unsigned int cycle = 0; cycle < n_steps; ++cycle) {
+    t += euler_module.step(U, t);
+    t_reference += reference_module.step(U_reference, t_reference);
+  }
+
+  const NUMBER norm = U_reference.l1_norm();
+  U_reference -= U;
+  const NUMBER difference = U_reference.linfty_norm();
+
+  if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
+    std::cout << "completed " << n_steps << " steps, t > 0: "
+              << (t > 0. ? "true" : "false") << std::endl;
+    std::cout << "same time steps: "
+              << (t == t_reference ? "true" : "false") << std::endl;
+    std::cout << "results match: "
+              << (norm > 0. && difference == 0. ? "true" : "false")
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <cmath>
+
+/*
+ * Store entries that are not representable in single precision and check
+ * that every accessor returns the entry rounded to the nearest float,
+ * i.e., with a relative error of at most 2^-24.
+ */
+
+double value(const unsigned int i, const unsigned int j)
+{
+  return 0.1 + (3. * i + j + 1.) / 3.;
+}
+
+int main()
+{
+  dealii::DynamicSparsityPattern spars(14, 14);
+  spars.add(0, 0);
+  spars.add(0, 1);
+  spars.add(0, 13);
+  for (unsigned int i = 1; i < 12; ++i) {
+    spars.add(i, i - 1);
+    spars.add(i, i);
+    spars.add(i, i + 1);
+  }
+  spars.add(12, 12);
+  spars.add(12, 11);
+  spars.add(13, 13);
+  spars.add(13, 0);
+  spars.compress();
+
+  dealii::IndexSet locally_owned(14);
+  locally_owned.add_range(0, 14);
+  dealii::IndexSet locally_relevant(14);
+  dealii::Utilities::MPI::Partitioner partitioner(
+      locally_owned, locally_relevant, MPI_COMM_SELF);
+
+  ryujin::SparsityPatternSIMD<4> my_sparsity(12, spars, partitioner);
+  ryujin::SparseMatrixSIMD<double, 1, 4, float> my_sparse(my_sparsity);
+
+  using VA = dealii::VectorizedArray<double, 4>;
+  for (unsigned int i = 0; i < 12; i += 4)
+    for (unsigned int j = 0; j < 3; ++j) {
+      VA entry;
+      for (unsigned int k = 0; k < 4; ++k)
+        entry[k] = value(i + k, j);
+      my_sparse.write_vectorized_entry(entry, i, j);
+    }
+  for (unsigned int i = 12; i < 14; ++i)
+    for (unsigned int j = 0; j < 2; ++j)
+      my_sparse.write_entry(value(i, j), i, j);
+
+  bool rounded = true;
+  bool within_bound = true;
+  bool inexact = false;
+
+  const auto check = [&](const double a, const double expected) {
+    rounded = rounded && (a == double(float(expected)));
+    within_bound = within_bound &&
+                   (std::abs(a - expected) <= std::ldexp(expected, -24));
+    inexact = inexact || (a != expected);
+  };
+
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i)
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j)
+      check(my_sparse.get_entry(i, j), value(i, j));
+
+  for (unsigned int i = 0; i < 12; i += 4)
+    for (unsigned int j = 0; j < 3; ++j) {
+      const auto a = my_sparse.get_vectorized_entry(i, j);
+      for (unsigned int k = 0; k < 4; ++k)
+        check(a[k], value(i + k, j));
+    }
+
+  /* The transposed entry of (i, j) is the entry (j, i): */
+  const auto position = [&](const unsigned int row, const unsigned int col) {
+    const unsigned int *js = my_sparsity.columns(row);
+    const unsigned int stride = my_sparsity.stride_of_row(row);
+    for (unsigned int k = 0; k < my_sparsity.row_length(row); ++k)
+      if (js[k * stride] == col)
+        return k;
+    return dealii::numbers::invalid_unsigned_int;
+  };
+
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i) {
+    const unsigned int *js = my_sparsity.columns(i);
+    const unsigned int stride = my_sparsity.stride_of_row(i);
+    for (unsigned int k = 0; k < my_sparsity.row_length(i); ++k) {
+      const unsigned int j = js[k * stride];
+      check(my_sparse.get_transposed_entry(i, k), value(j, position(j, i)));
+    }
+  }
+
+  for (unsigned int i = 0; i < 12; i += 4)
+    for (unsigned int k = 0; k < 3; ++k) {
+      const auto a = my_sparse.get_vectorized_transposed_entry(i, k);
+      for (unsigned int l = 0; l < 4; ++l) {
+        const unsigned int j =
+            my_sparsity.columns(i + l)[k * my_sparsity.stride_of_row(i + l)];
+        check(a[l], value(j, position(j, i + l)));
+      }
+    }
+
+  std::cout << "entries rounded to nearest float: "
+            << (rounded ? "true" : "false") << std::endl;
+  std::cout << "relative error at most 2^-24: "
+            << (within_bound ? "true" : "false") << std::endl;
+  std::cout << "conversion exercised: " << (inexact ? "true" : "false")
+            << std::endl;
+}
@@ -0,0 +1,79 @@
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+int main()
+{
+  /*
+   * Rows 0 - 3 and rows 4 - 7 form two SIMD row groups with row length 3
+   * and 4, rows 8 - 13 are stored in CSR format:
+   */
+  dealii::DynamicSparsityPattern spars(14, 14);
+  for (unsigned int i = 0; i < 14; ++i)
+    spars.add(i, i);
+  for (unsigned int i = 0; i < 13; ++i) {
+    spars.add(i, i + 1);
+    spars.add(i + 1, i);
+  }
+  spars.add(0, 9);
+  spars.add(9, 0);
+  for (unsigned int i = 4; i < 8; ++i) {
+    spars.add(i, i + 6);
+    spars.add(i + 6, i);
+  }
+  spars.compress();
+
+  dealii::IndexSet locally_owned(14);
+  locally_owned.add_range(0, 14);
+  dealii::IndexSet locally_relevant(14);
+  dealii::Utilities::MPI::Partitioner partitioner(
+      locally_owned, locally_relevant, MPI_COMM_SELF);
+
+  ryujin::SparsityPatternSIMD<4> my_sparsity(8, spars, partitioner);
+  ryujin::SparseMatrixSIMD<double, 1, 4> my_sparse(my_sparsity);
+
+  unsigned int n = 0;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i)
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j)
+      my_sparse.write_entry(n++, i, j);
+
+  std::cout << "Row lengths" << std::endl;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i)
+    std::cout << my_sparsity.row_length(i) << " ";
+  std::cout << std::endl;
+
+  std::cout << "Matrix entries row by row" << std::endl;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto a = my_sparse.get_entry(i, j);
+      std::cout << a << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  std::cout << "Matrix entries by SIMD rows" << std::endl;
+  for (unsigned int i = 0; i < 8; i += 4) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto a = my_sparse.get_vectorized_entry(i, j);
+      std::cout << a << "   ";
+    }
+    std::cout << std::endl;
+  }
+
+  std::cout << "Matrix entries transposed row by row" << std::endl;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto a = my_sparse.get_transposed_entry(i, j);
+      std::cout << a << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  std::cout << "Matrix entries transposed by SIMD row" << std::endl;
+  for (unsigned int i = 0; i < 8; i += 4) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto a = my_sparse.get_vectorized_transposed_entry(i, j);
+      std::cout << a << "   ";
+    }
+    std::cout << std::endl;
+  }
+}
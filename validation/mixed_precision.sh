@@ -0,0 +1,92 @@
+#!/bin/bash
+##
+## SPDX-License-Identifier: MIT
+## Copyright (C) 2020 by the ryujin authors
+##
+
+#
+# Validate the reduced-precision storage options (USE_MIXED_PRECISION*)
+# on the isentropic vortex configuration in validation.prm.
+#
+# A reference build (all options off) and one build per option are
+# configured in build-validation-<option> with CHECK_BOUNDS=ON. Every
+# build is run on the three refinement levels of validation.baseline with
+# the given MPI launcher (default: "mpirun -np 1"). The script prints the
+# normalized Linf, L1, and L2 errors at final time next to the reference
+# build and validation.baseline. It fails if an error of a
+# reduced-precision build exceeds the reference error by more than
+# TOLERANCE (relative, default: 1e-3).
+#
+# Usage: mixed_precision.sh <path to ryujin source> [mpi launcher]
+#
+
+set -e
+
+SOURCE="$(realpath "${1:-..}")"
+LAUNCHER="${2:-mpirun -np 1}"
+PRM="${SOURCE}/validation/validation.prm"
+BASELINE="${SOURCE}/validation/validation.baseline"
+TOLERANCE="${TOLERANCE:-1e-3}"
+
+OPTIONS="reference USE_MIXED_PRECISION USE_MIXED_PRECISION_PIJ
+  USE_MIXED_PRECISION_OFFLINE"
+REFINEMENTS="6 7 8"
+
+errors() {
+  grep -E "^(Linf|L1|L2) +=" "$1" | tail -n 3 | awk '{print $3}'
+}
+
+status=0
+for option in ${OPTIONS}; do
+  build="build-validation-${option}"
+  flags="-DCHECK_BOUNDS=ON"
+  [ "${option}" != "reference" ] && flags="${flags} -D${option}=ON"
+
+  mkdir -p "${build}"
+  (
+    cd "${build}"
+    cmake -DCMAKE_BUILD_TYPE=Release ${flags} "${SOURCE}" > /dev/null
+    make -j"$(nproc)" ryujin > /dev/null
+  )
+
+  for refinement in ${REFINEMENTS}; do
+    prm="${build}/run/validation-${refinement}.prm"
+    cat "${PRM}" > "${prm}"
+    cat >> "${prm}" << EOT
+
+subsection B - Discretization
+  set mesh refinement = ${refinement}
+end
+EOT
+    (
+      cd "${build}/run"
+      ${LAUNCHER} ./ryujin "$(basename "${prm}")" \
+        > "../validation-${refinement}.log"
+    )
+  done
+done
+
+for refinement in ${REFINEMENTS}; do
+  echo "mesh refinement = ${refinement}:"
+  level=$((refinement - 6))
+  baseline=$(grep -E "^(Linf|L1|L2) +=" "${BASELINE}" |
+    sed -n "$((3 * level + 1)),$((3 * level + 3))p" | awk '{print $3}')
+  reference=$(errors "build-validation-reference/validation-${refinement}.log")
+  echo "  baseline:  " ${baseline}
+  echo "  reference: " ${reference}
+
+  for option in ${OPTIONS}; do
+    [ "${option}" = "reference" ] && continue
+    result=$(errors "build-validation-${option}/validation-${refinement}.log")
+    echo "  ${option}: " ${result}
+    paste <(echo "${reference}") <(echo "${result}") |
+      awk -v tol="${TOLERANCE}" \
+        '{ if ($2 > $1 * (1. + tol)) exit 1 }' || {
+      echo "  !!! ${option} exceeds the reference errors"
+      status=1
+    }
+  done
+  echo
+done
+
+exit ${status}